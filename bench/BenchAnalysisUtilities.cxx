@@ -0,0 +1,594 @@
+/// ===========================================================================
+/*! \file   BenchAnalysisUtilities.cxx
+ *  \author Derek Anderson
+ *  \date   10.16.2026
+ *
+ *  Benchmarks for the ROOTAnalysisUtilities library,
+ *  run on synthetic data written to a scratch directory.
+ *  Can be built with CMake or run as a macro, e.g.
+ *
+ *    root -b -q BenchAnalysisUtilities.cxx++
+ *
+ *  If built with RAU_INSTRUMENT defined, the counters
+ *  and timers collected along the way are dumped at
+ *  the end.
+ */
+/// ===========================================================================
+
+#ifndef BenchAnalysisUtilities_cxx
+#define BenchAnalysisUtilities_cxx
+
+// c++ utilities
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+// root libraries
+#include <TFile.h>
+#include <TH1.h>
+#include <TNtuple.h>
+#include <TRandom3.h>
+#include <TROOT.h>
+#include <TSystem.h>
+// tmva components
+#include <TMVA/DataLoader.h>
+#include <TMVA/Factory.h>
+#include <TMVA/Reader.h>
+// analysis utility
+#include "../include/ROOTAnalysisUtilities.hxx"
+
+
+
+namespace Bench {
+
+  // --------------------------------------------------------------------------
+  //! Parameters of benchmarks
+  // --------------------------------------------------------------------------
+  struct Parameters {
+    std::string   directory = "./bench_output";  ///!< where to write scratch files
+    std::size_t   nentries  = 1000000;           ///!< no. of entries in synthetic tuple
+    std::size_t   nfills    = 1000000;           ///!< no. of values to fill per manager config
+    std::size_t   nmva      = 200000;            ///!< no. of entries to evaluate MVA on
+    std::size_t   nplots    = 20;                ///!< no. of times to make a plot
+    std::size_t   nthreads  = std::max(1u, std::thread::hardware_concurrency());
+  };
+
+  // --------------------------------------------------------------------------
+  //! Get seconds elapsed since a point in time
+  // --------------------------------------------------------------------------
+  double SecondsSince(const std::chrono::steady_clock::time_point& start) {
+
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+
+  }  // end 'SecondsSince(std::chrono::steady_clock::time_point&)'
+
+  // --------------------------------------------------------------------------
+  //! Print a result
+  // --------------------------------------------------------------------------
+  void Report(
+    const std::string& what,
+    const double count,
+    const std::string& unit,
+    const double seconds
+  ) {
+
+    std::cout << "      " << std::left << std::setw(40) << what
+              << std::right << std::setw(14) << std::setprecision(4) << (count / seconds)
+              << " " << unit << "/s"
+              << "  (" << seconds << " s)"
+              << std::endl;
+    return;
+
+  }  // end 'Report(std::string&, double, std::string&, double)'
+
+
+
+  // ==========================================================================
+  //! Synthetic data
+  // ==========================================================================
+  /*! Writes a TNtuple "tuple" of gaussian variables
+   *  (x, y, z, w) and a target t = x + 0.5y + noise.
+   */
+  void MakeTuple(const std::string& path, const std::size_t nentries) {
+
+    TFile    file(path.data(), "recreate");
+    TNtuple  tuple("tuple", "synthetic data", "x:y:z:w:t");
+    TRandom3 rng(42);
+    for (std::size_t ientry = 0; ientry < nentries; ++ientry) {
+      const float x = rng.Gaus(0., 1.);
+      const float y = rng.Gaus(0., 1.);
+      const float z = rng.Gaus(0., 2.);
+      const float w = rng.Uniform(0.5, 1.5);
+      tuple.Fill(x, y, z, w, x + (0.5 * y) + rng.Gaus(0., 0.1));
+    }
+    tuple.Write();
+    file.Close();
+    return;
+
+  }  // end 'MakeTuple(std::string&, std::size_t)'
+
+
+
+  // ==========================================================================
+  //! Histogram manager
+  // ==========================================================================
+  /*! A 2D index, e.g. (centrality bin, pt bin). */
+  class Index : public ROOTAnalysisUtilities::Hist::Index<2, std::size_t, std::size_t> {
+
+    public:
+
+      void Set(std::size_t row, std::size_t col) override {m_values = {row, col};}
+
+      std::string Hash() override {
+        return std::to_string(m_values[0]) + "_" + std::to_string(m_values[1]);
+      }
+
+  };  // end Index
+
+  /*! Content to fill with. */
+  struct Content {
+    double x = 0.;
+    double w = 1.;
+  };
+
+  /*! A grid of nrows x ncols indices, each with ndefs
+   *  1D histograms, stored flat.
+   */
+  class Manager : public ROOTAnalysisUtilities::Hist::Manager<Index, Content> {
+
+    private:
+
+      std::size_t              m_nrows = 1;
+      std::size_t              m_ncols = 1;
+      std::size_t              m_ndefs = 1;
+      std::vector<std::size_t> m_handles;
+
+      void CreateIndices() override {
+        for (std::size_t row = 0; row < m_nrows; ++row) {
+          for (std::size_t col = 0; col < m_ncols; ++col) {
+            Index index;
+            index.Set(row, col);
+            AddIndex(index);
+          }
+        }
+      }
+
+    public:
+
+      void GenerateHists() override {
+        SetIndexExtents({m_nrows, m_ncols});
+        CreateIndices();
+        for (std::size_t idef = 0; idef < m_ndefs; ++idef) {
+          m_handles.push_back(
+            AddDefinition1D(
+              ROOTAnalysisUtilities::Hist::Definition(
+                "hBench" + std::to_string(idef),
+                "",
+                {"x", "counts"},
+                {ROOTAnalysisUtilities::Hist::Binning(100, -5., 5.)}
+              )
+            )
+          );
+        }
+        CreateHistCollections();
+      }
+
+      void FillHists(Index index, Content content) override {
+        for (const std::size_t handle : m_handles) {
+          Fill1D(index, handle, content.x, content.w);
+        }
+      }
+
+      void FillWorkerHists(Index index, Content content, const std::size_t worker) override {
+        for (const std::size_t handle : m_handles) {
+          Fill1D(index, handle, content.x, content.w, worker);
+        }
+      }
+
+      void FillBatch(const Index& index, const std::vector<double>& xs, const std::vector<double>& ws) {
+        for (const std::size_t handle : m_handles) {
+          FillBatch1D(index, handle, xs, ws);
+        }
+      }
+
+      Manager(const std::size_t nrows, const std::size_t ncols, const std::size_t ndefs)
+        : ROOTAnalysisUtilities::Hist::Manager<Index, Content>(true, ROOTAnalysisUtilities::Types::Storage::Flat)
+        , m_nrows(nrows)
+        , m_ncols(ncols)
+        , m_ndefs(ndefs) {};
+
+  };  // end Manager
+
+  /*! Fill rate vs. no. of indices and definitions, one
+   *  value at a time and in batches of values per index.
+   */
+  void BenchManager(const Parameters& params) {
+
+    std::cout << "    Hist::Manager fill rate:" << std::endl;
+
+    const std::vector<std::array<std::size_t, 3>> configs = {
+      {2, 2, 4},
+      {8, 8, 8},
+      {16, 16, 16},
+      {32, 32, 4}
+    };
+    for (const auto& config : configs) {
+
+      const std::size_t nindex = config[0] * config[1];
+      const std::string label  = std::to_string(nindex) + " indices x " + std::to_string(config[2]) + " defs";
+
+      // generate values, grouped by index
+      TRandom3 rng(7);
+      std::vector<std::vector<double>> xvals(nindex);
+      std::vector<std::vector<double>> wvals(nindex);
+      for (std::size_t ival = 0; ival < params.nfills; ++ival) {
+        const std::size_t slot = rng.Integer(nindex);
+        xvals[slot].push_back( rng.Gaus(0., 1.5) );
+        wvals[slot].push_back( rng.Uniform(0.5, 1.5) );
+      }
+
+      // one value at a time
+      {
+        Manager manager(config[0], config[1], config[2]);
+        manager.GenerateHists();
+
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t slot = 0; slot < nindex; ++slot) {
+          Index index;
+          index.Set(slot / config[1], slot % config[1]);
+          for (std::size_t ival = 0; ival < xvals[slot].size(); ++ival) {
+            manager.FillHists(index, {xvals[slot][ival], wvals[slot][ival]});
+          }
+        }
+        Report(label + ", single", params.nfills * config[2], "fills", SecondsSince(start));
+      }
+
+      // in batches
+      {
+        Manager manager(config[0], config[1], config[2]);
+        manager.GenerateHists();
+
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t slot = 0; slot < nindex; ++slot) {
+          Index index;
+          index.Set(slot / config[1], slot % config[1]);
+          manager.FillBatch(index, xvals[slot], wvals[slot]);
+        }
+        Report(label + ", batch", params.nfills * config[2], "fills", SecondsSince(start));
+      }
+    }  // end config loop
+    return;
+
+  }  // end 'BenchManager(Parameters&)'
+
+  /*! Fill rate vs. no. of workers, each filling its own
+   *  shard in its own thread (including the merge).
+   */
+  void BenchWorkers(const Parameters& params) {
+
+    std::cout << "    Hist::Manager fill rate vs. workers:" << std::endl;
+
+    const std::size_t nrows = 16;
+    const std::size_t ncols = 16;
+    const std::size_t ndefs = 8;
+
+    // generate values and where they go
+    TRandom3 rng(8);
+    std::vector<Index>   indices(params.nfills);
+    std::vector<Content> contents(params.nfills);
+    for (std::size_t ival = 0; ival < params.nfills; ++ival) {
+      indices[ival].Set(rng.Integer(nrows), rng.Integer(ncols));
+      contents[ival] = {rng.Gaus(0., 1.5), rng.Uniform(0.5, 1.5)};
+    }
+
+    for (std::size_t nworkers = 1; nworkers <= params.nthreads; nworkers *= 2) {
+      Manager manager(nrows, ncols, ndefs);
+      manager.SetNWorkers(nworkers);
+      manager.GenerateHists();
+
+      const auto               start = std::chrono::steady_clock::now();
+      const std::size_t        nper  = (params.nfills + nworkers - 1) / nworkers;
+      std::vector<std::thread> threads;
+      for (std::size_t iwrk = 0; iwrk < nworkers; ++iwrk) {
+        threads.emplace_back(
+          [&, iwrk]() {
+            const std::size_t stop = std::min((iwrk + 1) * nper, params.nfills);
+            for (std::size_t ival = iwrk * nper; ival < stop; ++ival) {
+              manager.FillWorkerHists(indices[ival], contents[ival], iwrk);
+            }
+          }
+        );
+      }
+      for (auto& thread : threads) {
+        thread.join();
+      }
+      manager.MergeWorkers();
+      Report(std::to_string(nworkers) + " workers", params.nfills * ndefs, "fills", SecondsSince(start));
+    }
+    return;
+
+  }  // end 'BenchWorkers(Parameters&)'
+
+
+
+  // ==========================================================================
+  //! NTuple reading
+  // ==========================================================================
+  /*! Entry-by-entry reading through an NTupleHelper vs.
+   *  block-wise reading through an NTupleReader.
+   */
+  void BenchNTuple(const std::string& path) {
+
+    std::cout << "    NTuple read throughput:" << std::endl;
+
+    TFile*   file  = TFile::Open(path.data(), "read");
+    TNtuple* tuple = (TNtuple*) file -> Get("tuple");
+    double   sum   = 0.;
+
+    // entry by entry
+    {
+      ROOTAnalysisUtilities::NTupleHelper helper(tuple);
+      helper.SetBranches(tuple);
+
+      const std::size_t x     = helper.GetIndex("x");
+      const auto        start = std::chrono::steady_clock::now();
+      Long64_t          bytes = 0;
+      for (Long64_t ientry = 0; ientry < tuple -> GetEntries(); ++ientry) {
+        bytes += tuple -> GetEntry(ientry);
+        sum   += helper.GetVariable(x);
+      }
+      const double seconds = SecondsSince(start);
+      Report("NTupleHelper", tuple -> GetEntries(), "entries", seconds);
+      Report("NTupleHelper", bytes / 1e6, "MB", seconds);
+      tuple -> ResetBranchAddresses();
+    }
+
+    // block by block, with and without reading ahead
+    for (const bool ahead : {false, true}) {
+      ROOTAnalysisUtilities::NTupleReader reader(tuple, {"x", "y", "z", "w", "t"});
+      reader.SetReadAhead(ahead);
+
+      const std::size_t x     = reader.GetColumn("x");
+      const auto        start = std::chrono::steady_clock::now();
+      Long64_t          nread = 0;
+      while (reader.Next()) {
+        const float* vals = reader.GetData(x);
+        for (std::size_t ientry = 0; ientry < reader.GetSize(); ++ientry) {
+          sum += vals[ientry];
+        }
+        nread += reader.GetSize();
+      }
+      const double      seconds = SecondsSince(start);
+      const std::string label   = ahead ? "NTupleReader, read ahead" : "NTupleReader";
+      Report(label, nread, "entries", seconds);
+      Report(label, reader.GetBytesRead() / 1e6, "MB", seconds);
+    }
+
+    std::cout << "      (checksum = " << sum << ")" << std::endl;
+    file -> Close();
+    return;
+
+  }  // end 'BenchNTuple(std::string&)'
+
+
+
+  // ==========================================================================
+  //! MVA evaluation
+  // ==========================================================================
+  /*! Trains a linear discriminant on the synthetic data,
+   *  then evaluates it event by event and block by block.
+   */
+  void BenchMVA(const Parameters& params, const std::string& path) {
+
+    std::cout << "    MVA::ReadHelper evaluation rate:" << std::endl;
+
+    const std::vector<std::pair<ROOTAnalysisUtilities::Types::Use, std::string>> variables = {
+      {ROOTAnalysisUtilities::Types::Use::Target, "t"},
+      {ROOTAnalysisUtilities::Types::Use::Train,  "x"},
+      {ROOTAnalysisUtilities::Types::Use::Train,  "y"},
+      {ROOTAnalysisUtilities::Types::Use::Train,  "z"}
+    };
+    const std::vector<std::pair<std::string, std::string>> methods = {
+      {"LD", "!V"}
+    };
+
+    TFile*   file  = TFile::Open(path.data(), "read");
+    TNtuple* tuple = (TNtuple*) file -> Get("tuple");
+
+    // train
+    {
+      ROOTAnalysisUtilities::MVA::TrainHelper trainer(variables, methods);
+      trainer.SetFactoryOptions({"!V", "Silent", "AnalysisType=Regression"});
+      trainer.SetTrainOptions({"nTrain_Regression=10000", "nTest_Regression=1000", "SplitMode=Random", "!V"});
+
+      const std::string output  = params.directory + "/bench_training.root";
+      TFile*            ofile   = TFile::Open(output.data(), "recreate");
+      TMVA::Factory*    factory = new TMVA::Factory("bench", ofile, trainer.CompressFactoryOptions());
+      TMVA::DataLoader* loader  = new TMVA::DataLoader(params.directory);
+      trainer.LoadVariables(loader);
+      loader -> AddRegressionTree(tuple, 1.);
+      loader -> PrepareTrainingAndTestTree("", trainer.CompressTrainingOptions());
+      trainer.BookMethodsToTrain(factory, loader);
+      factory -> TrainAllMethods();
+      ofile -> cd();
+      ofile -> Close();
+      delete factory;
+      delete loader;
+    }
+
+    const Long64_t nevents = std::min<Long64_t>(params.nmva, tuple -> GetEntries());
+
+    // event by event
+    {
+      ROOTAnalysisUtilities::NTupleHelper    input(tuple);
+      ROOTAnalysisUtilities::MVA::ReadHelper helper(variables, methods);
+      TMVA::Reader* reader = new TMVA::Reader("!Color:Silent");
+      input.SetBranches(tuple);
+      helper.ReadVariables(reader, input);
+      helper.BookMethodsToRead(reader, params.directory, "bench");
+
+      const auto start = std::chrono::steady_clock::now();
+      for (Long64_t ientry = 0; ientry < nevents; ++ientry) {
+        tuple  -> GetEntry(ientry);
+        helper.ResetValues();
+        helper.EvaluateMethods(reader, input);
+      }
+      Report("EvaluateMethods", nevents, "events", SecondsSince(start));
+      tuple -> ResetBranchAddresses();
+      delete reader;
+    }
+
+    // block by block
+    {
+      ROOTAnalysisUtilities::MVA::ReadHelper helper(variables, methods);
+      helper.BookReaderPool(params.nthreads, params.directory, "bench");
+
+      ROOTAnalysisUtilities::NTupleReader block(tuple, {"x", "y", "z", "t"});
+      block.SetRange(0, nevents);
+
+      std::vector<std::vector<float>> outputs;
+      const auto start = std::chrono::steady_clock::now();
+      while (block.Next()) {
+        helper.EvaluateBlock(block, outputs);
+      }
+      Report("EvaluateBlock, " + std::to_string(params.nthreads) + " threads", nevents, "events", SecondsSince(start));
+    }
+
+    file -> Close();
+    return;
+
+  }  // end 'BenchMVA(Parameters&, std::string&)'
+
+
+
+  // ==========================================================================
+  //! Plotting
+  // ==========================================================================
+  /*! Latency of Plotter::Base::PlotSpectra for a few
+   *  spectra, opening inputs each time vs. through a
+   *  FileCache.
+   */
+  void BenchPlotter(const Parameters& params, const std::string& path) {
+
+    std::cout << "    Plotter::Base::PlotSpectra latency:" << std::endl;
+    gROOT -> SetBatch(true);
+
+    // make some spectra to plot
+    const std::string spectra = params.directory + "/bench_spectra.root";
+    {
+      TFile*   file  = TFile::Open(path.data(), "read");
+      TNtuple* tuple = (TNtuple*) file -> Get("tuple");
+      TFile*   ofile = TFile::Open(spectra.data(), "recreate");
+      for (const std::string var : {"x", "y", "z"}) {
+        TH1D* hist = new TH1D(("h" + var).data(), "", 100, -5., 5.);
+        tuple -> Draw((var + ">>h" + var).data(), "", "goff");
+        hist  -> Write();
+      }
+      ofile -> Close();
+      file  -> Close();
+    }
+
+    const Inputs inputs = {
+      {spectra, "hx", "hPlotX", "x", ROOTAnalysisUtilities::Plot::Style::Plot()},
+      {spectra, "hy", "hPlotY", "y", ROOTAnalysisUtilities::Plot::Style::Plot()},
+      {spectra, "hz", "hPlotZ", "z", ROOTAnalysisUtilities::Plot::Style::Plot()}
+    };
+    const ROOTAnalysisUtilities::Plot::Range  range({-5., 5.}, {0., 1e5});
+    const ROOTAnalysisUtilities::Plot::Canvas canvas("cBench", "", {800, 600}, ROOTAnalysisUtilities::Plot::PadOpts());
+
+    ROOTAnalysisUtilities::Plotter::Base      plotter;
+    ROOTAnalysisUtilities::Plotter::FileCache cache;
+    for (const bool cached : {false, true}) {
+
+      plotter.SetFileCache(cached ? &cache : nullptr);
+
+      const std::string output = params.directory + "/bench_plots.root";
+      TFile*            ofile  = TFile::Open(output.data(), "recreate");
+
+      // silence plotting printouts while timing
+      std::streambuf* buffer = std::cout.rdbuf(nullptr);
+
+      const auto start = std::chrono::steady_clock::now();
+      for (std::size_t iplot = 0; iplot < params.nplots; ++iplot) {
+        plotter.PlotSpectra(inputs, range, canvas, ofile, "bench");
+      }
+      const double seconds = SecondsSince(start);
+
+      std::cout.rdbuf(buffer);
+      ofile -> Close();
+      std::cout << "      " << std::left << std::setw(40) << (cached ? "PlotSpectra, cached" : "PlotSpectra")
+                << std::right << std::setw(14) << std::setprecision(4) << (1e3 * seconds / params.nplots)
+                << " ms/plot"
+                << std::endl;
+    }
+    plotter.SetFileCache(nullptr);
+    return;
+
+  }  // end 'BenchPlotter(Parameters&, std::string&)'
+
+}  // end Bench namespace
+
+
+
+// ============================================================================
+//! Run all benchmarks
+// ============================================================================
+void BenchAnalysisUtilities(const Bench::Parameters& params = Bench::Parameters()) {
+
+  std::cout << "\n -------------------------------- \n"
+            << "  Beginning benchmarks!\n"
+            << "    Output directory = " << params.directory
+            << std::endl;
+
+  gSystem -> mkdir(params.directory.data(), true);
+  const std::string tuple = params.directory + "/bench_tuple.root";
+  Bench::MakeTuple(tuple, params.nentries);
+  std::cout << "    Made synthetic tuple with " << params.nentries << " entries." << std::endl;
+
+  Bench::BenchManager(params);
+  Bench::BenchWorkers(params);
+  Bench::BenchNTuple(tuple);
+  Bench::BenchMVA(params, tuple);
+  Bench::BenchPlotter(params, tuple);
+
+  std::cout << "  Finished benchmarks!\n"
+            << " -------------------------------- \n"
+            << std::endl;
+
+  RAU_INSTRUMENT_DUMP();
+  return;
+
+}  // end 'BenchAnalysisUtilities(Bench::Parameters&)'
+
+
+
+#ifndef __CLING__
+// ============================================================================
+//! Main
+// ============================================================================
+/*! Optionally accepts an output directory and
+ *  no. of entries for the synthetic tuple.
+ */
+int main(int argc, char* argv[]) {
+
+  Bench::Parameters params;
+  if (argc > 1) params.directory = argv[1];
+  if (argc > 2) params.nentries  = std::strtoull(argv[2], nullptr, 10);
+
+  BenchAnalysisUtilities(params);
+  return 0;
+
+}  // end 'main(int, char*[])'
+#endif
+
+#endif
+
+// end ========================================================================
@@ -15,6 +15,7 @@
 // components
 #include "graph/Graph.hxx"
 #include "hist/Hist.hxx"
+#include "instrument/Instrument.hxx"
 #include "ntuple/NTuple.hxx"
 #include "plot/Plot.hxx"
 #include "plotter/Plotter.hxx"
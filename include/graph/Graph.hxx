@@ -12,6 +12,7 @@
 #define RAU_GRAPH_HXX
 
 // components
+#include "GraphColumns.hxx"
 #include "GraphDefinition.hxx"
 #include "GraphPoint.hxx"
 
@@ -0,0 +1,189 @@
+/// ===========================================================================
+/*! \file   GraphColumns.hxx
+ *  \author Derek Anderson
+ *  \date   10.16.2026
+ *
+ *  Column-wise storage of the points of a graph.
+ */
+/// ===========================================================================
+
+#ifndef RAU_GRAPHCOLUMNS_HXX
+#define RAU_GRAPHCOLUMNS_HXX
+
+// c++ utilities
+#include <cstddef>
+#include <limits>
+#include <vector>
+// rau components
+#include "GraphPoint.hxx"
+
+
+
+namespace ROOTAnalysisUtilities {
+  namespace Graph {
+
+    // ========================================================================
+    //! Columns
+    // ========================================================================
+    /*! A small struct to hold a set of points column
+     *  by column, i.e. all x values are contiguous, all
+     *  y values are contiguous, etc. This is the layout
+     *  ROOT graphs are built from, so each column can be
+     *  handed over as-is.
+     */
+    struct Columns {
+
+      // members
+      std::vector<double> x;
+      std::vector<double> y;
+      std::vector<double> z;
+      std::vector<double> ex;
+      std::vector<double> ex_lo;
+      std::vector<double> ex_hi;
+      std::vector<double> ey;
+      std::vector<double> ey_lo;
+      std::vector<double> ey_hi;
+      std::vector<double> ez;
+      std::vector<double> ez_lo;
+      std::vector<double> ez_hi;
+
+      // ----------------------------------------------------------------------
+      //! Get no. of points
+      // ----------------------------------------------------------------------
+      std::size_t GetSize() const {return x.size();}
+
+      // ----------------------------------------------------------------------
+      //! Apply a function to every column
+      // ----------------------------------------------------------------------
+      template <typename F> void ForEach(F func) {
+        for (auto column : {&x, &y, &z, &ex, &ex_lo, &ex_hi, &ey, &ey_lo, &ey_hi, &ez, &ez_lo, &ez_hi}) {
+          func(*column);
+        }
+      }
+
+      // ----------------------------------------------------------------------
+      //! Reserve space for a no. of points
+      // ----------------------------------------------------------------------
+      void Reserve(const std::size_t npoints) {
+
+        ForEach([npoints](std::vector<double>& column) {column.reserve(npoints);});
+        return;
+
+      }  // end 'Reserve(std::size_t)'
+
+      // ----------------------------------------------------------------------
+      //! Resize to a no. of points
+      // ----------------------------------------------------------------------
+      /*! New points get the same default values
+       *  as a default Point.
+       */
+      void Resize(const std::size_t npoints) {
+
+        ForEach(
+          [npoints](std::vector<double>& column) {
+            column.resize(npoints, std::numeric_limits<double>::max());
+          }
+        );
+        return;
+
+      }  // end 'Resize(std::size_t)'
+
+      // ----------------------------------------------------------------------
+      //! Remove all points
+      // ----------------------------------------------------------------------
+      void Clear() {
+
+        ForEach([](std::vector<double>& column) {column.clear();});
+        return;
+
+      }  // end 'Clear()'
+
+      // ----------------------------------------------------------------------
+      //! Add a point
+      // ----------------------------------------------------------------------
+      void AddPoint(const Point& point) {
+
+        x.push_back(point.x);
+        y.push_back(point.y);
+        z.push_back(point.z);
+        ex.push_back(point.ex);
+        ex_lo.push_back(point.ex_lo);
+        ex_hi.push_back(point.ex_hi);
+        ey.push_back(point.ey);
+        ey_lo.push_back(point.ey_lo);
+        ey_hi.push_back(point.ey_hi);
+        ez.push_back(point.ez);
+        ez_lo.push_back(point.ez_lo);
+        ez_hi.push_back(point.ez_hi);
+        return;
+
+      }  // end 'AddPoint(Point&)'
+
+      // ----------------------------------------------------------------------
+      //! Get a specific point
+      // ----------------------------------------------------------------------
+      Point GetPoint(const std::size_t index) const {
+
+        Point point;
+        point.x     = x[index];
+        point.y     = y[index];
+        point.z     = z[index];
+        point.ex    = ex[index];
+        point.ex_lo = ex_lo[index];
+        point.ex_hi = ex_hi[index];
+        point.ey    = ey[index];
+        point.ey_lo = ey_lo[index];
+        point.ey_hi = ey_hi[index];
+        point.ez    = ez[index];
+        point.ez_lo = ez_lo[index];
+        point.ez_hi = ez_hi[index];
+        return point;
+
+      }  // end 'GetPoint(std::size_t)'
+
+      // ----------------------------------------------------------------------
+      //! Get all points
+      // ----------------------------------------------------------------------
+      std::vector<Point> GetPoints() const {
+
+        std::vector<Point> points;
+        points.reserve( GetSize() );
+        for (std::size_t ipoint = 0; ipoint < GetSize(); ++ipoint) {
+          points.push_back( GetPoint(ipoint) );
+        }
+        return points;
+
+      }  // end 'GetPoints()'
+
+      // ----------------------------------------------------------------------
+      //! default ctor/dtor
+      // ----------------------------------------------------------------------
+      Columns()  {};
+      ~Columns() {};
+
+      // columns can be moved rather than copied
+      Columns(const Columns&)            = default;
+      Columns(Columns&&)                 = default;
+      Columns& operator=(const Columns&) = default;
+      Columns& operator=(Columns&&)      = default;
+
+      // ----------------------------------------------------------------------
+      //! ctor accepting a list of points
+      // ----------------------------------------------------------------------
+      Columns(const std::vector<Point>& points) {
+
+        Reserve( points.size() );
+        for (const Point& point : points) {
+          AddPoint(point);
+        }
+
+      }  // end ctor(std::vector<Point>&)
+
+    };  // end Columns
+
+  }  // end Graph namespace
+}  // end ROOTAnalysisUtilities namespace
+
+#endif
+
+// end ========================================================================
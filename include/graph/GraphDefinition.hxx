@@ -12,6 +12,7 @@
 
 // c++ utilities
 #include <string>
+#include <utility>
 #include <vector>
 // root libraries
 #include <TGraph.h>
@@ -23,6 +24,7 @@
 #include <TGraphAsymmErrors.h>
 #include <TGraphErrors.h>
 // rau components
+#include "GraphColumns.hxx"
 #include "GraphPoint.hxx"
 
 
@@ -36,108 +38,59 @@ namespace ROOTAnalysisUtilities {
      *  to define a TGraph, TGraphErrors, or
      *  TGraphAsymmErrors (and their 2D variants).
      *
+     *  Points are stored column by column (see Columns),
+     *  so graphs are built directly from the stored
+     *  columns without any intermediate copies.
+     *
      *  FIXME should also add TScatter...
      */ 
     class Definition {
 
       private:
 
-        // options for accessing specific members of a point
-        enum class Member {X, Y, Z, EX, EXlo, EXhi, EY, EYlo, EYhi, EZ, EZlo, EZhi};
-
         // data members
-        std::string        m_name;
-        std::vector<Point> m_points;
-
-        // --------------------------------------------------------------------
-        //! Helper method to pull a vector of x, y, etc. from a vector of points
-        // --------------------------------------------------------------------
-        std::vector<double> GetMembers(const Member member) const {
-
-          std::vector<double> members;
-          for (const auto& point : m_points) {
-
-            // select relevant member
-            switch (member) {
-
-              case Member::X:
-                members.push_back(point.x);
-                break;
-
-              case Member::Y:
-                members.push_back(point.y);
-                break;
-
-              case Member::Z:
-                members.push_back(point.z);
-                break;
-
-              case Member::EX:
-                members.push_back(point.ex);
-                break;
-
-              case Member::EXlo:
-                members.push_back(point.ex_lo);
-                break;
-
-              case Member::EXhi:
-                members.push_back(point.ex_hi);
-                break;
-
-              case Member::EY:
-                members.push_back(point.ey);
-                break;
-
-              case Member::EYlo:
-                members.push_back(point.ey_lo);
-                break;
-
-              case Member::EYhi:
-                members.push_back(point.ey_hi);
-                break;
-
-              case Member::EZ:
-                members.push_back(point.ez);
-                break;
-
-              case Member::EZlo:
-                members.push_back(point.ez_lo);
-                break;
-
-              case Member::EZhi:
-                members.push_back(point.ez_hi);
-                break;
-
-              // by default return nothing
-              default:
-                break;
-
-            }  // end switch(member)
-          }  // end point loop
-          return members;
-
-        }  // end 'GetMembers(Member)'
+        std::string m_name;
+        Columns     m_columns;
 
       public:
 
         // --------------------------------------------------------------------
         //! Getters
         // --------------------------------------------------------------------
-        std::string        GetName()   const {return m_name;}
-        std::vector<Point> GetPoints() const {return m_points;}
+        std::string        GetName()    const {return m_name;}
+        const Columns&     GetColumns() const {return m_columns;}
+        std::size_t        GetNPoints() const {return m_columns.GetSize();}
+        std::vector<Point> GetPoints()  const {return m_columns.GetPoints();}
 
         // --------------------------------------------------------------------
         //! Setters
         // --------------------------------------------------------------------
-        void SetName(const std::string& name)            {m_name = name;}
-        void SetPoints(const std::vector<Point>& points) {m_points = points;}
+        void SetName(const std::string& name)            {m_name    = name;}
+        void SetPoints(const std::vector<Point>& points) {m_columns = Columns(points);}
+        void SetColumns(const Columns& columns)          {m_columns = columns;}
+        void SetColumns(Columns&& columns)               {m_columns = std::move(columns);}
+
+        // --------------------------------------------------------------------
+        //! Set points, releasing the provided list
+        // --------------------------------------------------------------------
+        /*! The list is freed as soon as it's been
+         *  converted, rather than when the caller
+         *  lets go of it.
+         */
+        void SetPoints(std::vector<Point>&& points) {
+
+          m_columns = Columns(points);
+          std::vector<Point>().swap(points);
+          return;
+
+        }  // end 'SetPoints(std::vector<Point>&&)'
 
         // --------------------------------------------------------------------
         //! Reset points
         // --------------------------------------------------------------------
         void ResetPoints() {
 
-          m_points.clear();
+          m_columns.Clear();
           return;
 
         }  // end 'ResetPoints()'
@@ -147,7 +100,7 @@ namespace ROOTAnalysisUtilities {
         // --------------------------------------------------------------------
         void AddPoint(const Point& point) {
 
-          m_points.push_back(point);
+          m_columns.AddPoint(point);
           return;
 
         }  // end 'AddPoint(Point&)'
@@ -157,15 +110,11 @@ namespace ROOTAnalysisUtilities {
         // --------------------------------------------------------------------
         TGraph* MakeTGraph() const {
 
-          // decompose points
-          std::vector<double> x_vals = GetMembers(Member::X);
-          std::vector<double> y_vals = GetMembers(Member::Y);
-
           // create graph
           TGraph* graph = new TGraph(
-            m_points.size(),
-            x_vals.data(),
-            y_vals.data()
+            m_columns.GetSize(),
+            m_columns.x.data(),
+            m_columns.y.data()
           );
           graph -> SetName(m_name.data());
           return graph;
@@ -177,17 +126,12 @@ namespace ROOTAnalysisUtilities {
         // --------------------------------------------------------------------
         TGraph2D* MakeTGraph2D() const {
 
-          // decompose points
-          std::vector<double> x_vals = GetMembers(Member::X);
-          std::vector<double> y_vals = GetMembers(Member::Y);
-          std::vector<double> z_vals = GetMembers(Member::Z);
-
           // create graph
           TGraph2D* graph = new TGraph2D(
-            m_points.size(),
-            x_vals.data(),
-            y_vals.data(),
-            z_vals.data()
+            m_columns.GetSize(),
+            m_columns.x.data(),
+            m_columns.y.data(),
+            m_columns.z.data()
           );
           graph -> SetName(m_name.data());
           return graph;
@@ -199,19 +143,13 @@ namespace ROOTAnalysisUtilities {
         // --------------------------------------------------------------------
         TGraphErrors* MakeTGraphErrors() const {
 
-          // decompose points
-          std::vector<double> x_vals = GetMembers(Member::X);
-          std::vector<double> y_vals = GetMembers(Member::Y);
-          std::vector<double> x_errs = GetMembers(Member::EX);
-          std::vector<double> y_errs = GetMembers(Member::EY);
-
           // create graph
           TGraphErrors* graph = new TGraphErrors(
-            m_points.size(),
-            x_vals.data(),
-            y_vals.data(),
-            x_errs.data(),
-            y_errs.data()
+            m_columns.GetSize(),
+            m_columns.x.data(),
+            m_columns.y.data(),
+            m_columns.ex.data(),
+            m_columns.ey.data()
           );
           graph -> SetName(m_name.data());
           return graph;
@@ -223,23 +161,15 @@ namespace ROOTAnalysisUtilities {
         // --------------------------------------------------------------------
         TGraph2DErrors* MakeTGraph2DErrors() const {
 
-          // decompose points
-          std::vector<double> x_vals = GetMembers(Member::X);
-          std::vector<double> y_vals = GetMembers(Member::Y);
-          std::vector<double> z_vals = GetMembers(Member::Z);
-          std::vector<double> x_errs = GetMembers(Member::EX);
-          std::vector<double> y_errs = GetMembers(Member::EY);
-          std::vector<double> z_errs = GetMembers(Member::EZ);
-
           // create graph
           TGraph2DErrors* graph = new TGraph2DErrors(
-            m_points.size(),
-            x_vals.data(),
-            y_vals.data(),
-            z_vals.data(),
-            x_errs.data(),
-            y_errs.data(),
-            z_errs.data()
+            m_columns.GetSize(),
+            m_columns.x.data(),
+            m_columns.y.data(),
+            m_columns.z.data(),
+            m_columns.ex.data(),
+            m_columns.ey.data(),
+            m_columns.ez.data()
           );
           graph -> SetName(m_name.data());
           return graph;
@@ -251,23 +181,15 @@ namespace ROOTAnalysisUtilities {
         // --------------------------------------------------------------------
         TGraphAsymmErrors* MakeTGraphAsymmErrors() const {
 
-          // decompose points
-          std::vector<double> x_vals    = GetMembers(Member::X);
-          std::vector<double> y_vals    = GetMembers(Member::Y);
-          std::vector<double> x_lo_errs = GetMembers(Member::EXlo);
-          std::vector<double> x_hi_errs = GetMembers(Member::EXhi);
-          std::vector<double> y_lo_errs = GetMembers(Member::EYlo);
-          std::vector<double> y_hi_errs = GetMembers(Member::EYhi);
-
           // create graph
           TGraphAsymmErrors* graph = new TGraphAsymmErrors(
-            m_points.size(),
-            x_vals.data(),
-            y_vals.data(),
-            x_lo_errs.data(),
-            x_hi_errs.data(),
-            y_lo_errs.data(),
-            y_hi_errs.data()
+            m_columns.GetSize(),
+            m_columns.x.data(),
+            m_columns.y.data(),
+            m_columns.ex_lo.data(),
+            m_columns.ex_hi.data(),
+            m_columns.ey_lo.data(),
+            m_columns.ey_hi.data()
           );
           graph -> SetName(m_name.data());
           return graph;
@@ -280,29 +202,18 @@ namespace ROOTAnalysisUtilities {
         // --------------------------------------------------------------------
         TGraph2DAsymmErrors* MakeTGraph2DAsymmErrors() const {
 
-          // decompose points
-          std::vector<double> x_vals    = GetMembers(Member::X);
-          std::vector<double> y_vals    = GetMembers(Member::Y);
-          std::vector<double> z_vals    = GetMembers(Member::Z);
-          std::vector<double> x_lo_errs = GetMembers(Member::EXlo);
-          std::vector<double> x_hi_errs = GetMembers(Member::EXhi);
-          std::vector<double> y_lo_errs = GetMembers(Member::EYlo);
-          std::vector<double> y_hi_errs = GetMembers(Member::EYhi);
-          std::vector<double> z_lo_errs = GetMembers(Member::EZlo);
-          std::vector<double> z_hi_errs = GetMembers(Member::EZhi);
-
           // create graph
           TGraph2DAsymmErrors* graph = new TGraph2DAsymmErrors(
-            m_points.size(),
-            x_vals.data(),
-            y_vals.data(),
-            z_vals.data(),
-            x_lo_errs.data(),
-            x_hi_errs.data(),
-            y_lo_errs.data(),
-            y_hi_errs.data(),
-            z_lo_errs.data(),
-            z_hi_errs.data()
+            m_columns.GetSize(),
+            m_columns.x.data(),
+            m_columns.y.data(),
+            m_columns.z.data(),
+            m_columns.ex_lo.data(),
+            m_columns.ex_hi.data(),
+            m_columns.ey_lo.data(),
+            m_columns.ey_hi.data(),
+            m_columns.ez_lo.data(),
+            m_columns.ez_hi.data()
           );
           graph -> SetName(m_name.data());
           return graph;
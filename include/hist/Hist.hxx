@@ -12,11 +12,14 @@
 #define RAU_HIST_HXX
 
 // components
+#include "HistBinFinder.hxx"
 #include "HistBins.hxx"
 #include "HistBinning.hxx"
 #include "HistDefinition.hxx"
+#include "HistFiller.hxx"
 #include "HistIndex.hxx"
 #include "HistManager.hxx"
+#include "HistMerger.hxx"
 #include "HistTools.hxx"
 #include "HistTypes.hxx"
 
@@ -0,0 +1,191 @@
+/// ===========================================================================
+/*! \file   HistBinFinder.hxx
+ *  \author Derek Anderson
+ *  \date   10.16.2026
+ *
+ *  Fast lookup of bins along a histogram axis.
+ */
+/// ===========================================================================
+
+#ifndef RAU_HISTBINFINDER_HXX
+#define RAU_HISTBINFINDER_HXX
+
+// c++ utilities
+#include <cmath>
+#include <cstddef>
+#include <vector>
+// rau components
+#include "HistBinning.hxx"
+#include "HistTypes.hxx"
+
+
+
+namespace ROOTAnalysisUtilities {
+  namespace Hist {
+
+    // ==========================================================================
+    //! Bin finder
+    // ==========================================================================
+    /*! A small class to look up which bin of a binning a value
+     *  falls in, following the same conventions as TAxis::FindBin
+     *  (0 is underflow, num + 1 is overflow, and each bin
+     *  includes its low edge).
+     *
+     *  Since a histogram made from a Definition only knows about
+     *  its edges, ROOT always falls back to a binary search. Here
+     *  the spacing of the binning is used instead: uniform and log
+     *  binnings are located arithmetically, with the guess then
+     *  checked against the actual edges so the result always
+     *  matches ROOT. Variable binnings use a branchless search.
+     */
+    class BinFinder {
+
+      private:
+
+        // no. of edges below which a linear scan is used
+        static constexpr std::size_t m_max_scan = 32;
+
+        // data members
+        Types::Spacing      m_spacing = Types::Spacing::Variable;
+        std::size_t         m_num     = 0;
+        double              m_start   = 0.;
+        double              m_stop    = 0.;
+        double              m_offset  = 0.;
+        double              m_scale   = 0.;
+        std::vector<double> m_edges;
+
+        // ----------------------------------------------------------------------
+        //! Correct a guessed bin against the actual edges
+        // ----------------------------------------------------------------------
+        /*! Assumes value is in range, i.e. in [start, stop). */
+        std::size_t FixBin(const double value, const double guess) const {
+
+          std::size_t bin = (guess > 0.) ? static_cast<std::size_t>(guess) + 1 : 1;
+          if (bin > m_num) bin = m_num;
+
+          while ((bin > 1) && (value < m_edges[bin - 1])) --bin;
+          while ((bin < m_num) && (value >= m_edges[bin])) ++bin;
+          return bin;
+
+        }  // end 'FixBin(double, double)'
+
+        // ----------------------------------------------------------------------
+        //! Search edges
+        // ----------------------------------------------------------------------
+        /*! Assumes value is in range, i.e. in [start, stop). For a
+         *  handful of edges, simply counting how many edges are at
+         *  or below the value is fastest (and easy to vectorize).
+         *  Otherwise, a binary search where the only branch is the
+         *  loop itself is used.
+         */
+        std::size_t SearchEdges(const double value) const {
+
+          const double* edges = m_edges.data();
+          if (m_edges.size() <= m_max_scan) {
+            std::size_t count = 0;
+            for (std::size_t iedge = 0; iedge < m_edges.size(); ++iedge) {
+              count += (edges[iedge] <= value);
+            }
+            return count;
+          }
+
+          // find last edge at or below value
+          const double* base = edges;
+          std::size_t   size = m_edges.size();
+          while (size > 1) {
+            const std::size_t half = size / 2;
+            base  = (base[half] <= value) ? base + half : base;
+            size -= half;
+          }
+          return (base - edges) + 1;
+
+        }  // end 'SearchEdges(double)'
+
+      public:
+
+        // ----------------------------------------------------------------------
+        //! Getters
+        // ----------------------------------------------------------------------
+        Types::Spacing GetSpacing() const {return m_spacing;}
+        std::size_t    GetNum()     const {return m_num;}
+
+        // ----------------------------------------------------------------------
+        //! Find bin a value falls in
+        // ----------------------------------------------------------------------
+        std::size_t Find(const double value) const {
+
+          // check for under/overflow (NaN goes to overflow, as in TAxis)
+          if (value < m_start)    return 0;
+          if (!(value < m_stop))  return m_num + 1;
+
+          switch (m_spacing) {
+            case Types::Spacing::Uniform:
+              return FixBin(value, (value - m_offset) * m_scale);
+            case Types::Spacing::Log:
+              return FixBin(value, (std::log(value) - m_offset) * m_scale);
+            case Types::Spacing::Variable:
+              [[fallthrough]];
+            default:
+              return SearchEdges(value);
+          }
+
+        }  // end 'Find(double)'
+
+        // ----------------------------------------------------------------------
+        //! Find bins for a batch of values
+        // ----------------------------------------------------------------------
+        /*! Values can be of any floating-point type, and are
+         *  looked up as doubles (as TH1::Fill would).
+         */
+        template <typename T> void FindN(const T* values, const std::size_t nvalues, std::size_t* bins) const {
+
+          for (std::size_t ival = 0; ival < nvalues; ++ival) {
+            bins[ival] = Find(values[ival]);
+          }
+          return;
+
+        }  // end 'FindN(T*, std::size_t, std::size_t*)'
+
+        // ----------------------------------------------------------------------
+        //! default ctor/dtor
+        // ----------------------------------------------------------------------
+        BinFinder()  {};
+        ~BinFinder() {};
+
+        // ----------------------------------------------------------------------
+        //! ctor accepting a binning
+        // ----------------------------------------------------------------------
+        BinFinder(const Binning& binning) {
+
+          m_edges   = binning.GetBins();
+          m_spacing = binning.GetSpacing();
+          m_num     = m_edges.empty() ? 0 : m_edges.size() - 1;
+          m_start   = m_edges.empty() ? 0. : m_edges.front();
+          m_stop    = m_edges.empty() ? 0. : m_edges.back();
+
+          // set up arithmetic lookup
+          switch (m_spacing) {
+            case Types::Spacing::Uniform:
+              m_offset = m_start;
+              m_scale  = m_num / (m_stop - m_start);
+              break;
+            case Types::Spacing::Log:
+              m_offset = std::log(m_start);
+              m_scale  = m_num / (std::log(m_stop) - std::log(m_start));
+              break;
+            case Types::Spacing::Variable:
+              [[fallthrough]];
+            default:
+              break;
+          }
+
+        }  // end ctor(Binning&)
+
+    };  // end BinFinder
+
+  }  // end Hist namespace
+}  // end ROOTAnalysisUtilities namespace
+
+#endif
+
+// end ========================================================================
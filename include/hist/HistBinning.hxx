@@ -14,6 +14,7 @@
 #include <vector>
 // rau components
 #include "HistTools.hxx"
+#include "HistTypes.hxx"
 
 
 
@@ -35,6 +36,7 @@ namespace ROOTAnalysisUtilities {
         double              m_stop;
         uint32_t            m_num;
         std::vector<double> m_bins;
+        Types::Spacing      m_spacing = Types::Spacing::Variable;
 
       public:
 
@@ -50,6 +52,11 @@ namespace ROOTAnalysisUtilities {
         // ----------------------------------------------------------------------
         std::vector<double> GetBins() const {return m_bins;}
 
+        // ----------------------------------------------------------------------
+        //! Spacing getter
+        // ----------------------------------------------------------------------
+        Types::Spacing GetSpacing() const {return m_spacing;}
+
         // ----------------------------------------------------------------------
         //! default ctor/dtor
         // ----------------------------------------------------------------------
@@ -64,7 +71,8 @@ namespace ROOTAnalysisUtilities {
           m_num   = num;
           m_start = start;
           m_stop  = stop;
-          m_bins  = Tools::GetBinEdges(m_num, m_start, m_stop);
+          m_bins    = Tools::GetBinEdges(m_num, m_start, m_stop);
+          m_spacing = Types::Spacing::Uniform;
 
         }  // end ctor(uint32_t, double, double)
 
@@ -73,10 +81,11 @@ namespace ROOTAnalysisUtilities {
         // ----------------------------------------------------------------------
         Binning(const std::vector<double> edges) {
 
-          m_bins  = edges;
-          m_num   = edges.size() - 1;
-          m_start = edges.front();
-          m_stop  = edges.back();
+          m_bins    = edges;
+          m_num     = edges.size() - 1;
+          m_start   = edges.front();
+          m_stop    = edges.back();
+          m_spacing = Tools::GetBinSpacing(edges);
 
         }  // end ctor(std::vector<double>)
 
@@ -0,0 +1,320 @@
+/// ===========================================================================
+/*! \file   HistFiller.hxx
+ *  \author Derek Anderson
+ *  \date   10.16.2026
+ *
+ *  Batched filling of histograms made from a definition.
+ */
+/// ===========================================================================
+
+#ifndef RAU_HISTFILLER_HXX
+#define RAU_HISTFILLER_HXX
+
+// c++ utilities
+#include <algorithm>
+#include <array>
+#include <cstddef>
+// root libraries
+#include <TH1.h>
+#include <TH2.h>
+#include <TH3.h>
+// rau components
+#include "HistBinFinder.hxx"
+#include "HistDefinition.hxx"
+
+
+
+namespace ROOTAnalysisUtilities {
+  namespace Hist {
+
+    // --------------------------------------------------------------------------
+    //! Weights to go with a batch of values of type T
+    // --------------------------------------------------------------------------
+    /*! Weights are the same type as the values, but aren't
+     *  used to deduce it, so that nullptr can be passed.
+     */
+    template <typename T> struct WeightsOf {using type = const T*;};
+    template <typename T> using Weights = typename WeightsOf<T>::type;
+
+
+
+    // ==========================================================================
+    //! Histogram filler
+    // ==========================================================================
+    /*! A small class to fill batches of values into a TH1D,
+     *  TH2D, or TH3D made from a Definition. Bins are found
+     *  with a BinFinder for each axis, and the bin contents,
+     *  sum of squared weights, and statistics are then added
+     *  to directly, skipping the per-value TAxis::FindBin and
+     *  TH1::Fill calls.
+     *
+     *  The end result is the same as calling TH1::Fill for each
+     *  value (modulo the order floating-point sums are done in),
+     *  including switching on Sumw2 if a weight isn't 1.
+     *
+     *  Values and weights can be doubles or e.g. the float
+     *  columns of an NTupleReader, in which case they're
+     *  converted one at a time rather than copied.
+     */
+    class Filler {
+
+      private:
+
+        // no. of values to look up bins for at a time
+        static constexpr std::size_t m_chunk = 256;
+
+        // data members
+        BinFinder m_find_x;
+        BinFinder m_find_y;
+        BinFinder m_find_z;
+
+        // ----------------------------------------------------------------------
+        //! Get pointers to arrays to fill
+        // ----------------------------------------------------------------------
+        /*! Flushes any buffer the histogram has, and switches on
+         *  Sumw2 if it would be by TH1::Fill. Returns null for
+         *  the sum of squared weights if it's not being kept.
+         */
+        template <typename T> double* GetSumw2Array(TH1* hist, Weights<T> weights, const std::size_t nvalues) const {
+
+          hist -> BufferEmpty(1);
+          if ((hist -> GetSumw2N() == 0) && weights && !hist -> TestBit(TH1::kIsNotW)) {
+            const bool weighted = std::any_of(
+              weights,
+              weights + nvalues,
+              [](const T weight) {return weight != 1.;}
+            );
+            if (weighted) hist -> Sumw2();
+          }
+          return (hist -> GetSumw2N() > 0) ? hist -> GetSumw2() -> GetArray() : nullptr;
+
+        }  // end 'GetSumw2Array(TH1*, Weights<T>, std::size_t)'
+
+        // ----------------------------------------------------------------------
+        //! Add accumulated statistics to a histogram
+        // ----------------------------------------------------------------------
+        void AddStats(TH1* hist, const double* sums, const std::size_t nsums, const std::size_t nvalues) const {
+
+          double stats[TH1::kNstat] = {0.};
+          hist -> GetStats(stats);
+          for (std::size_t isum = 0; isum < nsums; ++isum) {
+            stats[isum] += sums[isum];
+          }
+          hist -> PutStats(stats);
+          hist -> SetEntries(hist -> GetEntries() + nvalues);
+          return;
+
+        }  // end 'AddStats(TH1*, double*, std::size_t, std::size_t)'
+
+      public:
+
+        // ----------------------------------------------------------------------
+        //! Getters
+        // ----------------------------------------------------------------------
+        const BinFinder& GetFinderX() const {return m_find_x;}
+        const BinFinder& GetFinderY() const {return m_find_y;}
+        const BinFinder& GetFinderZ() const {return m_find_z;}
+
+        // ----------------------------------------------------------------------
+        //! Fill a TH1D with a batch of values
+        // ----------------------------------------------------------------------
+        /*! If weights is null, all values get a weight of 1. */
+        template <typename T> void Fill(
+          TH1D* hist,
+          const T* xvals,
+          Weights<T> weights,
+          const std::size_t nvalues
+        ) const {
+
+          // n.b. emptying the buffer can rebin, so get
+          // contents only after
+          double* sumw2   = GetSumw2Array<T>(hist, weights, nvalues);
+          double* content = hist -> GetArray();
+
+          // stats: sumw, sumw2, sumwx, sumwx2
+          const bool            all_stats = hist -> GetStatOverflowsBehaviour();
+          const std::size_t     nx        = m_find_x.GetNum();
+          std::array<double, 4> sums      = {0., 0., 0., 0.};
+
+          std::array<std::size_t, m_chunk> xbins;
+          for (std::size_t start = 0; start < nvalues; start += m_chunk) {
+
+            const std::size_t size = std::min(m_chunk, nvalues - start);
+            m_find_x.FindN(xvals + start, size, xbins.data());
+
+            for (std::size_t ival = 0; ival < size; ++ival) {
+
+              const std::size_t bin    = xbins[ival];
+              const double      weight = weights ? weights[start + ival] : 1.;
+              const double      x      = xvals[start + ival];
+
+              content[bin] += weight;
+              if (sumw2) sumw2[bin] += weight * weight;
+
+              // only in-range values count towards stats
+              if (!all_stats && ((bin == 0) || (bin > nx))) continue;
+              sums[0] += weight;
+              sums[1] += weight * weight;
+              sums[2] += weight * x;
+              sums[3] += weight * x * x;
+            }
+          }
+          AddStats(hist, sums.data(), sums.size(), nvalues);
+          return;
+
+        }  // end 'Fill(TH1D*, T*, Weights<T>, std::size_t)'
+
+        // ----------------------------------------------------------------------
+        //! Fill a TH2D with a batch of values
+        // ----------------------------------------------------------------------
+        /*! If weights is null, all values get a weight of 1. */
+        template <typename T> void Fill(
+          TH2D* hist,
+          const T* xvals,
+          const T* yvals,
+          Weights<T> weights,
+          const std::size_t nvalues
+        ) const {
+
+          // n.b. emptying the buffer can rebin, so get
+          // contents only after
+          double* sumw2   = GetSumw2Array<T>(hist, weights, nvalues);
+          double* content = hist -> GetArray();
+
+          // stats: sumw, sumw2, sumwx, sumwx2, sumwy, sumwy2, sumwxy
+          const bool            all_stats = hist -> GetStatOverflowsBehaviour();
+          const std::size_t     nx        = m_find_x.GetNum();
+          const std::size_t     ny        = m_find_y.GetNum();
+          std::array<double, 7> sums      = {0., 0., 0., 0., 0., 0., 0.};
+
+          std::array<std::size_t, m_chunk> xbins;
+          std::array<std::size_t, m_chunk> ybins;
+          for (std::size_t start = 0; start < nvalues; start += m_chunk) {
+
+            const std::size_t size = std::min(m_chunk, nvalues - start);
+            m_find_x.FindN(xvals + start, size, xbins.data());
+            m_find_y.FindN(yvals + start, size, ybins.data());
+
+            for (std::size_t ival = 0; ival < size; ++ival) {
+
+              const std::size_t bin    = xbins[ival] + ((nx + 2) * ybins[ival]);
+              const double      weight = weights ? weights[start + ival] : 1.;
+              const double      x      = xvals[start + ival];
+              const double      y      = yvals[start + ival];
+
+              content[bin] += weight;
+              if (sumw2) sumw2[bin] += weight * weight;
+
+              // only in-range values count towards stats
+              const bool in_x = (xbins[ival] > 0) && (xbins[ival] <= nx);
+              const bool in_y = (ybins[ival] > 0) && (ybins[ival] <= ny);
+              if (!all_stats && !(in_x && in_y)) continue;
+              sums[0] += weight;
+              sums[1] += weight * weight;
+              sums[2] += weight * x;
+              sums[3] += weight * x * x;
+              sums[4] += weight * y;
+              sums[5] += weight * y * y;
+              sums[6] += weight * x * y;
+            }
+          }
+          AddStats(hist, sums.data(), sums.size(), nvalues);
+          return;
+
+        }  // end 'Fill(TH2D*, T* x 2, Weights<T>, std::size_t)'
+
+        // ----------------------------------------------------------------------
+        //! Fill a TH3D with a batch of values
+        // ----------------------------------------------------------------------
+        /*! If weights is null, all values get a weight of 1. */
+        template <typename T> void Fill(
+          TH3D* hist,
+          const T* xvals,
+          const T* yvals,
+          const T* zvals,
+          Weights<T> weights,
+          const std::size_t nvalues
+        ) const {
+
+          // n.b. emptying the buffer can rebin, so get
+          // contents only after
+          double* sumw2   = GetSumw2Array<T>(hist, weights, nvalues);
+          double* content = hist -> GetArray();
+
+          // stats: sumw, sumw2, sumwx, sumwx2, sumwy, sumwy2, sumwxy,
+          //        sumwz, sumwz2, sumwxz, sumwyz
+          const bool             all_stats = hist -> GetStatOverflowsBehaviour();
+          const std::size_t      nx        = m_find_x.GetNum();
+          const std::size_t      ny        = m_find_y.GetNum();
+          const std::size_t      nz        = m_find_z.GetNum();
+          std::array<double, 11> sums      = {0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0.};
+
+          std::array<std::size_t, m_chunk> xbins;
+          std::array<std::size_t, m_chunk> ybins;
+          std::array<std::size_t, m_chunk> zbins;
+          for (std::size_t start = 0; start < nvalues; start += m_chunk) {
+
+            const std::size_t size = std::min(m_chunk, nvalues - start);
+            m_find_x.FindN(xvals + start, size, xbins.data());
+            m_find_y.FindN(yvals + start, size, ybins.data());
+            m_find_z.FindN(zvals + start, size, zbins.data());
+
+            for (std::size_t ival = 0; ival < size; ++ival) {
+
+              const std::size_t bin    = xbins[ival] + ((nx + 2) * (ybins[ival] + ((ny + 2) * zbins[ival])));
+              const double      weight = weights ? weights[start + ival] : 1.;
+              const double      x      = xvals[start + ival];
+              const double      y      = yvals[start + ival];
+              const double      z      = zvals[start + ival];
+
+              content[bin] += weight;
+              if (sumw2) sumw2[bin] += weight * weight;
+
+              // only in-range values count towards stats
+              const bool in_x = (xbins[ival] > 0) && (xbins[ival] <= nx);
+              const bool in_y = (ybins[ival] > 0) && (ybins[ival] <= ny);
+              const bool in_z = (zbins[ival] > 0) && (zbins[ival] <= nz);
+              if (!all_stats && !(in_x && in_y && in_z)) continue;
+              sums[0]  += weight;
+              sums[1]  += weight * weight;
+              sums[2]  += weight * x;
+              sums[3]  += weight * x * x;
+              sums[4]  += weight * y;
+              sums[5]  += weight * y * y;
+              sums[6]  += weight * x * y;
+              sums[7]  += weight * z;
+              sums[8]  += weight * z * z;
+              sums[9]  += weight * x * z;
+              sums[10] += weight * y * z;
+            }
+          }
+          AddStats(hist, sums.data(), sums.size(), nvalues);
+          return;
+
+        }  // end 'Fill(TH3D*, T* x 3, Weights<T>, std::size_t)'
+
+        // ----------------------------------------------------------------------
+        //! default ctor/dtor
+        // ----------------------------------------------------------------------
+        Filler()  {};
+        ~Filler() {};
+
+        // ----------------------------------------------------------------------
+        //! ctor accepting a histogram definition
+        // ----------------------------------------------------------------------
+        Filler(const Definition& def) {
+
+          m_find_x = BinFinder( def.GetBinsX() );
+          m_find_y = BinFinder( def.GetBinsY() );
+          m_find_z = BinFinder( def.GetBinsZ() );
+
+        }  // end ctor(Definition&)
+
+    };  // end Filler
+
+  }  // end Hist namespace
+}  // end ROOTAnalysisUtilities namespace
+
+#endif
+
+// end ========================================================================
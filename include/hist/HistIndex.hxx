@@ -64,6 +64,13 @@ namespace ROOTAnalysisUtilities {
           return lhs.m_values == rhs.m_values;
         }
 
+        // --------------------------------------------------------------------
+        //! Get all indices
+        // --------------------------------------------------------------------
+        const std::array<std::size_t, N>& GetValues() const {
+          return m_values;
+        }
+
         // --------------------------------------------------------------------
         //! Get a specific index
         // --------------------------------------------------------------------
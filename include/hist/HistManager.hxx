@@ -11,17 +11,25 @@
 #define RAU_HISTMANAGER_HXX
 
 // c++ utilities
+#include <cassert>
+#include <iostream>
 #include <map>
+#include <mutex>
 #include <string>
 #include <vector>
 // root libraries
+#include <TDirectory.h>
 #include <TFile.h>
 #include <TH1.h>
 #include <TH2.h>
 #include <TH3.h>
+#include <TROOT.h>
 // rau components
+#include "../instrument/InstrumentMacros.hxx"
 #include "HistDefinition.hxx"
+#include "HistFiller.hxx"
 #include "HistIndex.hxx"
+#include "HistTypes.hxx"
 
 
 
@@ -38,6 +46,15 @@ namespace ROOTAnalysisUtilities {
     // ------------------------------------------------------------------------
     template <typename T, typename U> using HistGrid = std::map<T, HistMap<U>>;
 
+    // ------------------------------------------------------------------------
+    //! Names which identify a histogram made by a manager
+    // ------------------------------------------------------------------------
+    struct HistName {
+      std::string definition;  ///!< name of definition
+      std::string index;       ///!< string representation of index
+      std::string name;        ///!< full name of histogram
+    };
+
 
 
     // ========================================================================
@@ -61,20 +78,223 @@ namespace ROOTAnalysisUtilities {
      *        histograms;
      *    (3) and define how to fill all histograms for a given
      *        index.
-     */ 
+     *
+     *  Histograms can be stored in one of two ways (see
+     *  Types::Storage). By default, every histogram for every
+     *  index is built up front and kept in a map. For large,
+     *  sparsely-populated grids the flat storage can be used
+     *  instead: the index is mapped onto a dense, linear slot
+     *  using the extents provided to `SetIndexExtents`, every
+     *  definition gets an integer handle, and histograms are
+     *  only built once they're filled. These are kept out of
+     *  any directory (they may be built while an input file
+     *  is the current one) and are deleted with the manager.
+     *
+     *  Flat storage can also be split into several shards, one
+     *  per worker (e.g. per RDataFrame slot), so that the grid
+     *  can be filled from multiple threads. Each worker only
+     *  ever touches its own shard, and the shards are summed
+     *  into the first one by `MergeWorkers`, always in order
+     *  of worker, before saving. For example:
+     *
+     *    manager.SetNWorkers( frame.GetNSlots() );
+     *    manager.GenerateHists();
+     *    frame.ForeachSlot(
+     *      [&](unsigned int slot, ...) {
+     *        manager.FillWorkerHists(index, content, slot);
+     *      },
+     *      columns
+     *    );
+     *    manager.MergeWorkers();
+     *    manager.SaveHists(file);
+     *
+     *  Batches of values can be filled in one go with `FillBatch1D`,
+     *  etc., which skip the per-value TAxis and TH1 overhead (see
+     *  Hist::Filler).
+     */
     template <typename I, typename C> class Manager {
 
       private:
 
         // data members
-        bool                    m_do_errors;
-        std::vector<I>          m_indices;
-        std::vector<Definition> m_defs_1d;
-        std::vector<Definition> m_defs_2d;
-        std::vector<Definition> m_defs_3d;
-        HistGrid<I, TH1D*>      m_hists_1d;
-        HistGrid<I, TH2D*>      m_hists_2d;
-        HistGrid<I, TH3D*>      m_hists_3d;
+        bool                     m_do_errors = false;
+        std::size_t              m_nslots    = 0;
+        std::size_t              m_nworkers  = 1;
+        Types::Storage           m_storage   = Types::Storage::Grid;
+        std::vector<I>           m_indices;
+        std::vector<std::size_t> m_extents;
+        std::vector<std::size_t> m_strides;
+        std::vector<Definition>  m_defs_1d;
+        std::vector<Definition>  m_defs_2d;
+        std::vector<Definition>  m_defs_3d;
+        std::vector<Filler>      m_fillers_1d;
+        std::vector<Filler>      m_fillers_2d;
+        std::vector<Filler>      m_fillers_3d;
+        HistGrid<I, TH1D*>       m_hists_1d;
+        HistGrid<I, TH2D*>       m_hists_2d;
+        HistGrid<I, TH3D*>       m_hists_3d;
+
+        // flat storage (one shard per worker)
+        std::vector<std::vector<TH1D*>> m_flat_1d;
+        std::vector<std::vector<TH2D*>> m_flat_2d;
+        std::vector<std::vector<TH3D*>> m_flat_3d;
+
+        // guards histogram construction across workers
+        std::mutex m_make_mutex;
+
+        // --------------------------------------------------------------------
+        //! Make a histogram for a specific index
+        // --------------------------------------------------------------------
+        TH1D* MakeHist1D(const Definition& def, const I& index) {
+
+          Definition named = def;
+          named.SetHistName( CreateHistName(def.GetName(), index) );
+
+          TH1D* hist = named.MakeTH1();
+          hist -> Sumw2( m_do_errors );
+          RAU_COUNT("hist.allocations", 1);
+          return hist;
+
+        }  // end 'MakeHist1D(Definition&, I&)'
+
+        TH2D* MakeHist2D(const Definition& def, const I& index) {
+
+          Definition named = def;
+          named.SetHistName( CreateHistName(def.GetName(), index) );
+
+          TH2D* hist = named.MakeTH2();
+          hist -> Sumw2( m_do_errors );
+          RAU_COUNT("hist.allocations", 1);
+          return hist;
+
+        }  // end 'MakeHist2D(Definition&, I&)'
+
+        TH3D* MakeHist3D(const Definition& def, const I& index) {
+
+          Definition named = def;
+          named.SetHistName( CreateHistName(def.GetName(), index) );
+
+          TH3D* hist = named.MakeTH3();
+          hist -> Sumw2( m_do_errors );
+          RAU_COUNT("hist.allocations", 1);
+          return hist;
+
+        }  // end 'MakeHist3D(Definition&, I&)'
+
+        // --------------------------------------------------------------------
+        //! Get string representation of an index
+        // --------------------------------------------------------------------
+        /*! Index::Hash() isn't const, so a copy is hashed
+         *  rather than the index itself.
+         */
+        static std::string HashIndex(I index) {
+
+          return index.Hash();
+
+        }  // end 'HashIndex(I)'
+
+        // --------------------------------------------------------------------
+        //! Get position of a histogram in the flat storage
+        // --------------------------------------------------------------------
+        std::size_t GetFlatPosition(
+          const I& index,
+          const std::size_t handle,
+          const std::size_t ndefs
+        ) const {
+
+          const std::size_t slot = GetSlot(index);
+          assert(slot < m_nslots);
+          assert(handle < ndefs);
+          return (slot * ndefs) + handle;
+
+        }  // end 'GetFlatPosition(I&, std::size_t, std::size_t)'
+
+        // --------------------------------------------------------------------
+        //! Get a histogram from a worker's shard, making it if need be
+        // --------------------------------------------------------------------
+        /*! Histograms in flat storage are built mid-loop, so
+         *  they're always kept out of the current directory
+         *  (which could be e.g. an input file) and are owned
+         *  by the manager. This also means workers never touch
+         *  shared state (beyond the lock needed to build them).
+         */
+        template <typename H, typename M> H* GetOrMakeHist(
+          H*& hist,
+          const Definition& def,
+          const I& index,
+          M make
+        ) {
+
+          if (!hist) {
+            std::unique_lock<std::mutex> lock(m_make_mutex, std::defer_lock);
+            if (m_nworkers > 1) lock.lock();
+
+            TDirectory::TContext context(nullptr);
+            hist = (this ->* make)(def, index);
+            hist -> SetDirectory(nullptr);
+          }
+          return hist;
+
+        }  // end 'GetOrMakeHist(H*&, Definition&, I&, M)'
+
+        // --------------------------------------------------------------------
+        //! Delete all histograms in a set of shards
+        // --------------------------------------------------------------------
+        template <typename H> void DeleteShards(std::vector<std::vector<H*>>& shards) {
+
+          for (auto& shard : shards) {
+            for (H* hist : shard) {
+              delete hist;
+            }
+          }
+          shards.clear();
+          return;
+
+        }  // end 'DeleteShards(std::vector<std::vector<H*>>&)'
+
+        // --------------------------------------------------------------------
+        //! Sum a set of shards into the first one
+        // --------------------------------------------------------------------
+        /*! Adopted and summed histograms alike end up in
+         *  the first shard, which the manager still owns.
+         */
+        template <typename H> void MergeShards(std::vector<std::vector<H*>>& shards) {
+
+          for (std::size_t iwrk = 1; iwrk < shards.size(); ++iwrk) {
+            for (std::size_t ipos = 0; ipos < shards[iwrk].size(); ++ipos) {
+
+              H*& shard = shards[iwrk][ipos];
+              if (!shard) continue;
+
+              // adopt shard if main one was never filled,
+              // otherwise add to it
+              H*& main = shards[0][ipos];
+              if (!main) {
+                main = shard;
+              } else {
+                main -> Add(shard);
+                delete shard;
+              }
+              shard = nullptr;
+            }
+          }
+          return;
+
+        }  // end 'MergeShards(std::vector<std::vector<H*>>&)'
+
+        // --------------------------------------------------------------------
+        //! Check if any shard past the first still holds histograms
+        // --------------------------------------------------------------------
+        template <typename H> static bool HasUnmerged(const std::vector<std::vector<H*>>& shards) {
+
+          for (std::size_t iwrk = 1; iwrk < shards.size(); ++iwrk) {
+            for (const H* hist : shards[iwrk]) {
+              if (hist) return true;
+            }
+          }
+          return false;
+
+        }  // end 'HasUnmerged(std::vector<std::vector<H*>>&)'
 
       protected:
 
@@ -87,7 +307,7 @@ namespace ROOTAnalysisUtilities {
          */
         virtual std::string CreateHistName(const std::string hist, const I& index) {
 
-          return hist + "_" + index.Hash();
+          return hist + "_" + HashIndex(index);
 
         }  // end 'CreateHistName(std::string, I&)'
 
@@ -98,33 +318,82 @@ namespace ROOTAnalysisUtilities {
          *  based on the indices defined by `m_indices` and
          *  the histograms defined by `m_defs_*`. Can be
          *  overwritten.
-         */ 
+         *
+         *  With flat storage, this only reserves a slot for
+         *  each possible histogram in each worker's shard:
+         *  they're built on first fill.
+         */
         virtual void CreateHistCollections() {
 
-          // turn on errors if needed
-          TH1::SetDefaultSumw2( m_do_errors );
-          TH2::SetDefaultSumw2( m_do_errors );
-          TH3::SetDefaultSumw2( m_do_errors );
+          // if using flat storage, reserve slots and exit
+          if (m_storage == Types::Storage::Flat) {
+            assert(m_nslots > 0);
+            DeleteShards(m_flat_1d);
+            DeleteShards(m_flat_2d);
+            DeleteShards(m_flat_3d);
+            m_flat_1d.assign(m_nworkers, std::vector<TH1D*>(m_nslots * m_defs_1d.size(), nullptr));
+            m_flat_2d.assign(m_nworkers, std::vector<TH2D*>(m_nslots * m_defs_2d.size(), nullptr));
+            m_flat_3d.assign(m_nworkers, std::vector<TH3D*>(m_nslots * m_defs_3d.size(), nullptr));
+            return;
+          }
 
-          // create histograms
+          // otherwise create histograms
           for (const auto& index : m_indices) {
-            for (const auto def : m_defs_1d) {
-              def.AppendToName( CreateHistName(def.GetName(), index) );
-              m_hists_1d[index].push_back( def.MakeTH1() );
+            for (const auto& def : m_defs_1d) {
+              m_hists_1d[index][def.GetName()] = MakeHist1D(def, index);
             }
-            for (const auto def : m_defs_2d) {
-              def.AppendToName( CreateHistName(def.GetName(), index) );
-              m_hists_2d[index].push_back( def.MakeTH2() );
+            for (const auto& def : m_defs_2d) {
+              m_hists_2d[index][def.GetName()] = MakeHist2D(def, index);
             }
-            for (const auto def : m_defs_3d) {
-              def.AppendToName( CreateHistName(def.GetName(), index) );
-              m_hists_3d[index].push_back( def.MakeTH3() );
+            for (const auto& def : m_defs_3d) {
+              m_hists_3d[index][def.GetName()] = MakeHist3D(def, index);
             }
           }
           return;
 
         }  // end 'CreateHistCollection()'
 
+        // --------------------------------------------------------------------
+        //! Add an index
+        // --------------------------------------------------------------------
+        void AddIndex(const I& index) {
+
+          m_indices.push_back(index);
+          return;
+
+        }  // end 'AddIndex(I&)'
+
+        // --------------------------------------------------------------------
+        //! Add histogram definitions
+        // --------------------------------------------------------------------
+        /*! Returns a handle to the definition which can be
+         *  used to look up the corresponding histogram for
+         *  a given index.
+         */
+        std::size_t AddDefinition1D(const Definition& def) {
+
+          m_defs_1d.push_back(def);
+          m_fillers_1d.emplace_back(def);
+          return m_defs_1d.size() - 1;
+
+        }  // end 'AddDefinition1D(Definition&)'
+
+        std::size_t AddDefinition2D(const Definition& def) {
+
+          m_defs_2d.push_back(def);
+          m_fillers_2d.emplace_back(def);
+          return m_defs_2d.size() - 1;
+
+        }  // end 'AddDefinition2D(Definition&)'
+
+        std::size_t AddDefinition3D(const Definition& def) {
+
+          m_defs_3d.push_back(def);
+          m_fillers_3d.emplace_back(def);
+          return m_defs_3d.size() - 1;
+
+        }  // end 'AddDefinition3D(Definition&)'
+
         // --------------------------------------------------------------------
         //! Create tags for bins
         // --------------------------------------------------------------------
@@ -138,20 +407,448 @@ namespace ROOTAnalysisUtilities {
         // --------------------------------------------------------------------
         //! Setters
         // --------------------------------------------------------------------
-        void SetDoSumw2(const bool sumw2) {m_do_errors = sumw2;}
+        void SetDoSumw2(const bool sumw2)             {m_do_errors = sumw2;}
+        void SetStorage(const Types::Storage storage) {m_storage   = storage;}
 
         // --------------------------------------------------------------------
         //! Getters
         // --------------------------------------------------------------------
-        bool        GetDoSumw2()  const {return m_do_errors;}
-        std::size_t GetNIndices() const {return m_indices.size();}
-        std::size_t GetNHist1D()  const {return m_indices.size() * m_defs_1d.size();}
-        std::size_t GetNHist2D()  const {return m_indices.size() * m_defs_2d.size();}
-        std::size_t GetNHist3D()  const {return m_indices.size() * m_defs_3d.size();}
+        bool           GetDoSumw2()  const {return m_do_errors;}
+        Types::Storage GetStorage()  const {return m_storage;}
+        std::size_t    GetNSlots()   const {return m_nslots;}
+        std::size_t    GetNWorkers() const {return m_nworkers;}
+        std::size_t    GetNIndices() const {return m_indices.size();}
+        std::size_t    GetNHist1D()  const {return m_indices.size() * m_defs_1d.size();}
+        std::size_t    GetNHist2D()  const {return m_indices.size() * m_defs_2d.size();}
+        std::size_t    GetNHist3D()  const {return m_indices.size() * m_defs_3d.size();}
+
+        // --------------------------------------------------------------------
+        //! Set extent of each dimension of the index
+        // --------------------------------------------------------------------
+        /*! Needed for flat storage: defines how many values
+         *  each dimension of the index can take, which in
+         *  turn defines the no. of linear slots.
+         */
+        void SetIndexExtents(const std::vector<std::size_t>& extents) {
+
+          // strides are row-major: last dimension varies fastest
+          m_extents = extents;
+          m_strides.assign(extents.size(), 1);
+          for (std::size_t idim = extents.size(); idim > 1; --idim) {
+            m_strides[idim - 2] = m_strides[idim - 1] * extents[idim - 1];
+          }
+
+          // total no. of slots is product of extents
+          m_nslots = extents.empty() ? 0 : m_strides.front() * extents.front();
+          return;
+
+        }  // end 'SetIndexExtents(std::vector<std::size_t>&)'
+
+        // --------------------------------------------------------------------
+        //! Set no. of workers which will fill histograms
+        // --------------------------------------------------------------------
+        /*! Each worker gets its own shard of the (flat) storage.
+         *  Needs to be set before the histogram collections
+         *  are created.
+         */
+        void SetNWorkers(const std::size_t nworkers) {
+
+          // throw error if not using flat storage
+          const bool is_flat = (m_storage == Types::Storage::Flat) || (nworkers <= 1);
+          if (!is_flat) {
+            std::cerr << "PANIC: multiple workers require flat storage!" << std::endl;
+            assert(is_flat);
+          }
+
+          // throw error if shards were already made
+          const bool is_unsharded = m_flat_1d.empty() && m_flat_2d.empty() && m_flat_3d.empty();
+          if (!is_unsharded) {
+            std::cerr << "PANIC: no. of workers must be set before the histogram collections are created!" << std::endl;
+            assert(is_unsharded);
+          }
+
+          // histograms will be made in multiple threads
+          if (nworkers > 1) {
+            ROOT::EnableThreadSafety();
+          }
+          m_nworkers = (nworkers > 0) ? nworkers : 1;
+          return;
+
+        }  // end 'SetNWorkers(std::size_t)'
+
+        // --------------------------------------------------------------------
+        //! Merge all workers' shards into the first one
+        // --------------------------------------------------------------------
+        /*! Must be called after all workers are done filling
+         *  and before saving. Shards are always summed in order
+         *  of worker, so the result is reproducible.
+         */
+        void MergeWorkers() {
+
+          MergeShards(m_flat_1d);
+          MergeShards(m_flat_2d);
+          MergeShards(m_flat_3d);
+          return;
+
+        }  // end 'MergeWorkers()'
+
+        // --------------------------------------------------------------------
+        //! Get linear slot corresponding to an index
+        // --------------------------------------------------------------------
+        std::size_t GetSlot(const I& index) const {
+
+          const auto& values = index.GetValues();
+          assert(values.size() == m_strides.size());
+
+          std::size_t slot = 0;
+          for (std::size_t idim = 0; idim < m_strides.size(); ++idim) {
+            assert(values[idim] < m_extents[idim]);
+            slot += values[idim] * m_strides[idim];
+          }
+          return slot;
+
+        }  // end 'GetSlot(I&)'
+
+        // --------------------------------------------------------------------
+        //! Get no. of histograms which have actually been built
+        // --------------------------------------------------------------------
+        std::size_t GetNAllocated() const {
+
+          // with the grid, everything is built up front
+          if (m_storage == Types::Storage::Grid) {
+            return GetNHist1D() + GetNHist2D() + GetNHist3D();
+          }
+
+          std::size_t nalloc = 0;
+          for (const auto& shard : m_flat_1d) {
+            for (const TH1D* hist : shard) if (hist) ++nalloc;
+          }
+          for (const auto& shard : m_flat_2d) {
+            for (const TH2D* hist : shard) if (hist) ++nalloc;
+          }
+          for (const auto& shard : m_flat_3d) {
+            for (const TH3D* hist : shard) if (hist) ++nalloc;
+          }
+          return nalloc;
+
+        }  // end 'GetNAllocated()'
+
+        // --------------------------------------------------------------------
+        //! List every histogram the manager can make
+        // --------------------------------------------------------------------
+        /*! Returns the definition, index, and full name of each
+         *  histogram (1D, then 2D, then 3D, index by index),
+         *  e.g. to pass to a Hist::Merger.
+         */
+        std::vector<HistName> ListHists() {
+
+          std::vector<HistName> names;
+          names.reserve( GetNHist1D() + GetNHist2D() + GetNHist3D() );
+          for (const auto* defs : {&m_defs_1d, &m_defs_2d, &m_defs_3d}) {
+            for (const auto& index : m_indices) {
+              for (const auto& def : *defs) {
+                names.push_back(
+                  {def.GetName(), HashIndex(index), CreateHistName(def.GetName(), index)}
+                );
+              }
+            }
+          }
+          return names;
+
+        }  // end 'ListHists()'
+
+        // --------------------------------------------------------------------
+        //! Get a histogram for a given index and definition handle
+        // --------------------------------------------------------------------
+        /*! With flat storage, the histogram is built if it
+         *  hasn't been already. The worker selects which
+         *  shard to pull from.
+         */
+        TH1D* GetHist1D(
+          const I& index,
+          const std::size_t handle,
+          const std::size_t worker = 0
+        ) {
+
+          RAU_COUNT("hist.lookups", 1);
+          if (m_storage == Types::Storage::Grid) {
+            return m_hists_1d.at(index).at( m_defs_1d.at(handle).GetName() );
+          }
+
+          // throw error if worker has no shard
+          if (worker >= m_flat_1d.size()) {
+            std::cerr << "PANIC: no shard for worker " << worker << "! Was SetNWorkers called after GenerateHists?" << std::endl;
+            assert(worker < m_flat_1d.size());
+          }
+
+          return GetOrMakeHist(
+            m_flat_1d[worker][ GetFlatPosition(index, handle, m_defs_1d.size()) ],
+            m_defs_1d[handle],
+            index,
+            &Manager::MakeHist1D
+          );
+
+        }  // end 'GetHist1D(I&, std::size_t, std::size_t)'
+
+        TH2D* GetHist2D(
+          const I& index,
+          const std::size_t handle,
+          const std::size_t worker = 0
+        ) {
+
+          RAU_COUNT("hist.lookups", 1);
+          if (m_storage == Types::Storage::Grid) {
+            return m_hists_2d.at(index).at( m_defs_2d.at(handle).GetName() );
+          }
+
+          // throw error if worker has no shard
+          if (worker >= m_flat_2d.size()) {
+            std::cerr << "PANIC: no shard for worker " << worker << "! Was SetNWorkers called after GenerateHists?" << std::endl;
+            assert(worker < m_flat_2d.size());
+          }
+
+          return GetOrMakeHist(
+            m_flat_2d[worker][ GetFlatPosition(index, handle, m_defs_2d.size()) ],
+            m_defs_2d[handle],
+            index,
+            &Manager::MakeHist2D
+          );
+
+        }  // end 'GetHist2D(I&, std::size_t, std::size_t)'
+
+        TH3D* GetHist3D(
+          const I& index,
+          const std::size_t handle,
+          const std::size_t worker = 0
+        ) {
+
+          RAU_COUNT("hist.lookups", 1);
+          if (m_storage == Types::Storage::Grid) {
+            return m_hists_3d.at(index).at( m_defs_3d.at(handle).GetName() );
+          }
+
+          // throw error if worker has no shard
+          if (worker >= m_flat_3d.size()) {
+            std::cerr << "PANIC: no shard for worker " << worker << "! Was SetNWorkers called after GenerateHists?" << std::endl;
+            assert(worker < m_flat_3d.size());
+          }
+
+          return GetOrMakeHist(
+            m_flat_3d[worker][ GetFlatPosition(index, handle, m_defs_3d.size()) ],
+            m_defs_3d[handle],
+            index,
+            &Manager::MakeHist3D
+          );
+
+        }  // end 'GetHist3D(I&, std::size_t, std::size_t)'
+
+        // --------------------------------------------------------------------
+        //! Fill a histogram for a given index and definition handle
+        // --------------------------------------------------------------------
+        void Fill1D(
+          const I& index,
+          const std::size_t handle,
+          const double x,
+          const double weight = 1.,
+          const std::size_t worker = 0
+        ) {
+
+          RAU_COUNT("hist.fills", 1);
+          GetHist1D(index, handle, worker) -> Fill(x, weight);
+          return;
+
+        }  // end 'Fill1D(I&, std::size_t, double, double, std::size_t)'
+
+        void Fill2D(
+          const I& index,
+          const std::size_t handle,
+          const double x,
+          const double y,
+          const double weight = 1.,
+          const std::size_t worker = 0
+        ) {
+
+          RAU_COUNT("hist.fills", 1);
+          GetHist2D(index, handle, worker) -> Fill(x, y, weight);
+          return;
+
+        }  // end 'Fill2D(I&, std::size_t, double x 2, double, std::size_t)'
+
+        void Fill3D(
+          const I& index,
+          const std::size_t handle,
+          const double x,
+          const double y,
+          const double z,
+          const double weight = 1.,
+          const std::size_t worker = 0
+        ) {
+
+          RAU_COUNT("hist.fills", 1);
+          GetHist3D(index, handle, worker) -> Fill(x, y, z, weight);
+          return;
+
+        }  // end 'Fill3D(I&, std::size_t, double x 3, double, std::size_t)'
+
+        // --------------------------------------------------------------------
+        //! Fill a histogram with a batch of values
+        // --------------------------------------------------------------------
+        /*! Values (and weights) can be e.g. doubles, or a
+         *  block of floats from an NTupleReader, and are read
+         *  in place. If weights is null, all values get a
+         *  weight of 1.
+         */
+        template <typename T> void FillBatch1D(
+          const I& index,
+          const std::size_t handle,
+          const T* xvals,
+          Weights<T> weights,
+          const std::size_t nvalues,
+          const std::size_t worker = 0
+        ) {
+
+          RAU_COUNT("hist.fills", nvalues);
+          m_fillers_1d[handle].Fill(
+            GetHist1D(index, handle, worker),
+            xvals,
+            weights,
+            nvalues
+          );
+          return;
+
+        }  // end 'FillBatch1D(I&, std::size_t, T*, Weights<T>, std::size_t x 2)'
+
+        template <typename T> void FillBatch2D(
+          const I& index,
+          const std::size_t handle,
+          const T* xvals,
+          const T* yvals,
+          Weights<T> weights,
+          const std::size_t nvalues,
+          const std::size_t worker = 0
+        ) {
+
+          RAU_COUNT("hist.fills", nvalues);
+          m_fillers_2d[handle].Fill(
+            GetHist2D(index, handle, worker),
+            xvals,
+            yvals,
+            weights,
+            nvalues
+          );
+          return;
+
+        }  // end 'FillBatch2D(I&, std::size_t, T* x 2, Weights<T>, std::size_t x 2)'
+
+        template <typename T> void FillBatch3D(
+          const I& index,
+          const std::size_t handle,
+          const T* xvals,
+          const T* yvals,
+          const T* zvals,
+          Weights<T> weights,
+          const std::size_t nvalues,
+          const std::size_t worker = 0
+        ) {
+
+          RAU_COUNT("hist.fills", nvalues);
+          m_fillers_3d[handle].Fill(
+            GetHist3D(index, handle, worker),
+            xvals,
+            yvals,
+            zvals,
+            weights,
+            nvalues
+          );
+          return;
+
+        }  // end 'FillBatch3D(I&, std::size_t, T* x 3, Weights<T>, std::size_t x 2)'
+
+        // --------------------------------------------------------------------
+        //! Fill a histogram with vectors of values
+        // --------------------------------------------------------------------
+        /*! If no weights are provided, all values get a
+         *  weight of 1.
+         */
+        void FillBatch1D(
+          const I& index,
+          const std::size_t handle,
+          const std::vector<double>& xvals,
+          const std::vector<double>& weights = {},
+          const std::size_t worker = 0
+        ) {
+
+          assert(weights.empty() || (weights.size() == xvals.size()));
+          FillBatch1D<double>(
+            index,
+            handle,
+            xvals.data(),
+            weights.empty() ? nullptr : weights.data(),
+            xvals.size(),
+            worker
+          );
+          return;
+
+        }  // end 'FillBatch1D(I&, std::size_t, std::vector<double>& x 2, std::size_t)'
+
+        void FillBatch2D(
+          const I& index,
+          const std::size_t handle,
+          const std::vector<double>& xvals,
+          const std::vector<double>& yvals,
+          const std::vector<double>& weights = {},
+          const std::size_t worker = 0
+        ) {
+
+          assert(yvals.size() == xvals.size());
+          assert(weights.empty() || (weights.size() == xvals.size()));
+          FillBatch2D<double>(
+            index,
+            handle,
+            xvals.data(),
+            yvals.data(),
+            weights.empty() ? nullptr : weights.data(),
+            xvals.size(),
+            worker
+          );
+          return;
+
+        }  // end 'FillBatch2D(I&, std::size_t, std::vector<double>& x 3, std::size_t)'
+
+        void FillBatch3D(
+          const I& index,
+          const std::size_t handle,
+          const std::vector<double>& xvals,
+          const std::vector<double>& yvals,
+          const std::vector<double>& zvals,
+          const std::vector<double>& weights = {},
+          const std::size_t worker = 0
+        ) {
+
+          assert((yvals.size() == xvals.size()) && (zvals.size() == xvals.size()));
+          assert(weights.empty() || (weights.size() == xvals.size()));
+          FillBatch3D<double>(
+            index,
+            handle,
+            xvals.data(),
+            yvals.data(),
+            zvals.data(),
+            weights.empty() ? nullptr : weights.data(),
+            xvals.size(),
+            worker
+          );
+          return;
+
+        }  // end 'FillBatch3D(I&, std::size_t, std::vector<double>& x 4, std::size_t)'
 
         // --------------------------------------------------------------------
         //! Save histograms to a file
         // --------------------------------------------------------------------
+        /*! With flat storage, histograms which were never
+         *  built or never filled are skipped. Only the first
+         *  shard is saved, so if using multiple workers
+         *  `MergeWorkers` must be called beforehand.
+         */
         void SaveHists(TFile* file) const {
 
           // throw error if cd fails
@@ -160,19 +857,42 @@ namespace ROOTAnalysisUtilities {
             assert(good_cd);
           }
 
-          // loop through histogram maps
-          for (const auto row : m_hists_1d) {
-            for (const auto hists : row) {
+          // loop through flat storage if needed
+          if (m_storage == Types::Storage::Flat) {
+
+            // throw error if any worker's shard wasn't merged
+            const bool is_merged = !HasUnmerged(m_flat_1d) && !HasUnmerged(m_flat_2d) && !HasUnmerged(m_flat_3d);
+            if (!is_merged) {
+              std::cerr << "PANIC: workers' shards must be merged with MergeWorkers() before saving!" << std::endl;
+              assert(is_merged);
+            }
+
+            if (m_flat_1d.empty()) return;
+            for (TH1D* hist : m_flat_1d.front()) {
+              if (hist && (hist -> GetEntries() > 0)) hist -> Write();
+            }
+            for (TH2D* hist : m_flat_2d.front()) {
+              if (hist && (hist -> GetEntries() > 0)) hist -> Write();
+            }
+            for (TH3D* hist : m_flat_3d.front()) {
+              if (hist && (hist -> GetEntries() > 0)) hist -> Write();
+            }
+            return;
+          }
+
+          // otherwise loop through histogram maps
+          for (const auto& row : m_hists_1d) {
+            for (const auto& hists : row.second) {
               hists.second -> Write();
             }
           }
-          for (const auto row : m_hists_2d) {
-            for (const auto hists : row) {
+          for (const auto& row : m_hists_2d) {
+            for (const auto& hists : row.second) {
               hists.second -> Write();
             }
           }
-          for (const auto row : m_hists_3d) {
-            for (const auto hists : row) {
+          for (const auto& row : m_hists_3d) {
+            for (const auto& hists : row.second) {
               hists.second -> Write();
             }
           }
@@ -185,7 +905,7 @@ namespace ROOTAnalysisUtilities {
         // --------------------------------------------------------------------
         /*! Derived class must specify how to
          *  generate all possible histograms.
-         */ 
+         */
         virtual void GenerateHists() = 0;
 
         // --------------------------------------------------------------------
@@ -194,20 +914,55 @@ namespace ROOTAnalysisUtilities {
         /*! Derived class must specify how to
          *  fill a row of histograms given
          *  an index and content.
-         */ 
+         */
         virtual void FillHists(I index, C content) = 0;
 
+        // --------------------------------------------------------------------
+        //! Fill histograms from a specific worker
+        // --------------------------------------------------------------------
+        /*! Derived class should override this to fill the
+         *  worker's shard (i.e. pass `worker` on to `Fill1D`,
+         *  etc.) if filling from multiple threads. By default,
+         *  only a single worker is supported.
+         */
+        virtual void FillWorkerHists(I index, C content, const std::size_t worker) {
+
+          if (worker != 0) {
+            std::cerr << "PANIC: FillWorkerHists(I, C, std::size_t) must be overwritten to use multiple workers!" << std::endl;
+            assert(worker == 0);
+          }
+          FillHists(index, content);
+          return;
+
+        }  // end 'FillWorkerHists(I, C, std::size_t)'
+
         // --------------------------------------------------------------------
         //! default ctor/dtor
         // --------------------------------------------------------------------
-        Manager()  {} 
-        ~Manager() {};
+        /*! Histograms in flat storage are owned by the
+         *  manager, those in the grid by the directory
+         *  they were made in.
+         */
+        Manager() {}
+        virtual ~Manager() {
+          DeleteShards(m_flat_1d);
+          DeleteShards(m_flat_2d);
+          DeleteShards(m_flat_3d);
+        };
 
         // --------------------------------------------------------------------
         //! ctor accepting whether or not to do errors
         // --------------------------------------------------------------------
         Manager(const bool sumw2) {m_do_errors = sumw2;}
 
+        // --------------------------------------------------------------------
+        //! ctor accepting whether or not to do errors and storage
+        // --------------------------------------------------------------------
+        Manager(const bool sumw2, const Types::Storage storage) {
+          m_do_errors = sumw2;
+          m_storage   = storage;
+        }
+
     };  // end Manager
 
   }  // end Hist namespace
@@ -0,0 +1,496 @@
+/// ===========================================================================
+/*! \file   HistMerger.hxx
+ *  \author Derek Anderson
+ *  \date   10.16.2026
+ *
+ *  Chunked, parallel merging of histograms saved by
+ *  many managers.
+ */
+/// ===========================================================================
+
+#ifndef RAU_HISTMERGER_HXX
+#define RAU_HISTMERGER_HXX
+
+// c++ utilities
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+// root libraries
+#include <TClass.h>
+#include <TDirectory.h>
+#include <TFile.h>
+#include <TH1.h>
+#include <TKey.h>
+#include <TList.h>
+#include <TROOT.h>
+// rau components
+#include "../instrument/InstrumentMacros.hxx"
+#include "../mva/MVAWorkerPool.hxx"
+#include "HistManager.hxx"
+
+
+
+namespace ROOTAnalysisUtilities {
+  namespace Hist {
+
+    // ========================================================================
+    //! Histogram merger
+    // ========================================================================
+    /*! A class to merge the histograms saved by many
+     *  Hist::Managers (e.g. one per grid job) into a
+     *  single file.
+     *
+     *  Inputs are merged in groups of at most `SetMaxOpenFiles`
+     *  files, and every file of a group is opened once and
+     *  kept open while its histograms are merged a chunk of
+     *  names at a time. So memory is bounded by:
+     *    - (chunk size) x (no. of threads) partial histograms,
+     *      plus one being read per thread; and
+     *    - one group of open files, each of which holds its
+     *      full list of keys (roughly 100 B per histogram)
+     *      and its own read buffers.
+     *  The second term usually dominates when inputs hold
+     *  many histograms, so the no. of open files defaults to
+     *  a modest 64. If there are more inputs than fit in a
+     *  group, each group is first merged into a temporary file
+     *  next to the output, and those are then merged in turn.
+     *
+     *  Within a group, the files are split into contiguous
+     *  blocks, one per thread, and each thread sums its block
+     *  into a partial histogram. Partials are then combined
+     *  pairwise (0+1, 2+3, then 0+2, ...), so for a given set
+     *  of inputs, no. of threads, and group size the result is
+     *  always the same. The same threads are reused for every
+     *  step of a merge.
+     *
+     *  In the output, each histogram is written to a directory
+     *  named after its definition. Since ROOT only reads a
+     *  directory's keys once it's accessed, `LoadSlice` can
+     *  then read back a single definition without touching the
+     *  rest of the file:
+     *
+     *    Hist::Merger merger(inputs);
+     *    merger.SetHists( manager.ListHists() );
+     *    merger.SetNThreads(8);
+     *    merger.Merge(output);
+     *    ...
+     *    auto hists = Hist::Merger::LoadSlice(output, "hEne");
+     *
+     *  If `SetHists` isn't called, the histograms are listed
+     *  from the inputs instead (see `ListHistsFromInput`). A
+     *  file doesn't record which definition a histogram came
+     *  from, so in that case every histogram is written to the
+     *  top of the output and `LoadSlice` can't be used.
+     */
+    class Merger {
+
+      private:
+
+        // members
+        std::size_t              m_chunk     = 1000;
+        std::size_t              m_max_open  = 64;
+        std::size_t              m_nthreads  = 1;
+        std::vector<std::string> m_inputs;
+        std::vector<HistName>    m_hists;
+
+        // --------------------------------------------------------------------
+        //! Run a function over a range on a pool of threads
+        // --------------------------------------------------------------------
+        /*! Range is split into contiguous blocks, and the
+         *  function is called as func(iThread, start, stop).
+         */
+        template <typename F> static void RunSplit(
+          MVA::WorkerPool& workers,
+          const std::size_t size,
+          F func
+        ) {
+
+          const std::size_t nThreads = std::min(workers.GetNWorkers(), std::max<std::size_t>(size, 1));
+          const std::size_t nPer     = (size + nThreads - 1) / nThreads;
+          workers.Run(
+            nThreads,
+            [&](const std::size_t iThread) {
+              const std::size_t start = std::min(iThread * nPer, size);
+              const std::size_t stop  = std::min(start + nPer, size);
+              func(iThread, start, stop);
+            }
+          );
+          return;
+
+        }  // end 'RunSplit(MVA::WorkerPool&, std::size_t, F)'
+
+        // --------------------------------------------------------------------
+        //! Add one histogram to another, taking ownership of it
+        // --------------------------------------------------------------------
+        /*! Either can be null (e.g. if a job never filled
+         *  a particular histogram).
+         */
+        static TH1* Absorb(TH1* sum, TH1* hist) {
+
+          if (!hist) return sum;
+          if (!sum)  return hist;
+
+          sum -> Add(hist);
+          delete hist;
+          return sum;
+
+        }  // end 'Absorb(TH1*, TH1*)'
+
+        // --------------------------------------------------------------------
+        //! Merge a chunk of histograms across a group of open files
+        // --------------------------------------------------------------------
+        std::vector<TH1*> MergeChunk(
+          MVA::WorkerPool& workers,
+          const std::vector<TFile*>& files,
+          const std::size_t first,
+          const std::size_t last
+        ) const {
+
+          RAU_TIME_SCOPE("hist.merge_chunk");
+
+          const std::size_t nHists   = last - first;
+          const std::size_t nThreads = std::min(workers.GetNWorkers(), std::max<std::size_t>(files.size(), 1));
+
+          // sum each thread's block of files into partials
+          std::vector<std::vector<TH1*>> partials(nThreads, std::vector<TH1*>(nHists, nullptr));
+          RunSplit(
+            workers,
+            files.size(),
+            [&](const std::size_t iThread, const std::size_t start, const std::size_t stop) {
+              for (std::size_t iFile = start; iFile < stop; ++iFile) {
+                if (!files[iFile]) continue;
+
+                for (std::size_t iHist = 0; iHist < nHists; ++iHist) {
+                  TH1* hist = dynamic_cast<TH1*>( files[iFile] -> Get(m_hists[first + iHist].name.data()) );
+                  if (!hist) continue;
+
+                  hist -> SetDirectory(nullptr);
+                  partials[iThread][iHist] = Absorb(partials[iThread][iHist], hist);
+                  RAU_COUNT("hist.merge_reads", 1);
+                }
+              }
+            }
+          );
+
+          // then combine partials pairwise
+          RunSplit(
+            workers,
+            nHists,
+            [&](const std::size_t, const std::size_t start, const std::size_t stop) {
+              for (std::size_t iHist = start; iHist < stop; ++iHist) {
+                for (std::size_t stride = 1; stride < nThreads; stride *= 2) {
+                  for (std::size_t iPart = 0; iPart + stride < nThreads; iPart += 2 * stride) {
+                    partials[iPart][iHist] = Absorb(partials[iPart][iHist], partials[iPart + stride][iHist]);
+                    partials[iPart + stride][iHist] = nullptr;
+                  }
+                }
+              }
+            }
+          );
+          return partials.front();
+
+        }  // end 'MergeChunk(MVA::WorkerPool&, std::vector<TFile*>&, std::size_t, std::size_t)'
+
+        // --------------------------------------------------------------------
+        //! Merge a group of inputs into a file
+        // --------------------------------------------------------------------
+        /*! Each input is opened once. If `by_definition` is set,
+         *  histograms go into a directory per definition (if
+         *  known), otherwise they're written as-is so the file
+         *  can be merged again. Returns the no. of histograms
+         *  written.
+         */
+        std::size_t MergeGroup(
+          MVA::WorkerPool& workers,
+          const std::vector<std::string>& inputs,
+          TFile* output,
+          const bool by_definition
+        ) const {
+
+          // open all inputs of group up front
+          std::vector<TFile*> files(inputs.size(), nullptr);
+          RunSplit(
+            workers,
+            inputs.size(),
+            [&](const std::size_t, const std::size_t start, const std::size_t stop) {
+              TDirectory::TContext context(nullptr);
+              for (std::size_t iInput = start; iInput < stop; ++iInput) {
+                TFile* file = TFile::Open(inputs[iInput].data(), "read");
+                if (!file || file -> IsZombie()) {
+                  std::cerr << "WARNING: couldn't open input '" << inputs[iInput] << "', skipping." << std::endl;
+                  delete file;
+                  continue;
+                }
+                files[iInput] = file;
+              }
+            }
+          );
+
+          // merge chunk by chunk, and write as we go
+          std::size_t                        nWritten = 0;
+          std::map<std::string, TDirectory*> dirs;
+          for (std::size_t first = 0; first < m_hists.size(); first += m_chunk) {
+            const std::size_t last   = std::min(first + m_chunk, m_hists.size());
+            std::vector<TH1*> merged = MergeChunk(workers, files, first, last);
+            for (std::size_t iHist = 0; iHist < merged.size(); ++iHist) {
+              if (!merged[iHist]) continue;
+
+              const HistName& name = m_hists[first + iHist];
+              TDirectory*     dir  = output;
+              if (by_definition && !name.definition.empty()) {
+                TDirectory*& found = dirs[name.definition];
+                if (!found) found = output -> GetDirectory( name.definition.data() );
+                if (!found) found = output -> mkdir( name.definition.data() );
+                dir = found;
+              }
+              dir -> WriteTObject( merged[iHist], name.name.data() );
+              delete merged[iHist];
+              ++nWritten;
+            }
+          }
+
+          // close inputs
+          for (TFile* file : files) {
+            if (!file) continue;
+            file -> Close();
+            delete file;
+          }
+          return nWritten;
+
+        }  // end 'MergeGroup(MVA::WorkerPool&, std::vector<std::string>&, TFile*, bool)'
+
+      public:
+
+        // --------------------------------------------------------------------
+        //! Getters
+        // --------------------------------------------------------------------
+        std::size_t                     GetChunkSize()    const {return m_chunk;}
+        std::size_t                     GetMaxOpenFiles() const {return m_max_open;}
+        std::size_t                     GetNThreads()     const {return m_nthreads;}
+        const std::vector<std::string>& GetInputs()       const {return m_inputs;}
+        const std::vector<HistName>&    GetHists()        const {return m_hists;}
+
+        // --------------------------------------------------------------------
+        //! Setters
+        // --------------------------------------------------------------------
+        void SetChunkSize(const std::size_t chunk)              {m_chunk    = (chunk > 0) ? chunk : 1;}
+        void SetMaxOpenFiles(const std::size_t max_open)        {m_max_open = (max_open > 1) ? max_open : 2;}
+        void SetInputs(const std::vector<std::string>& inputs) {m_inputs   = inputs;}
+        void SetHists(const std::vector<HistName>& hists)      {m_hists    = hists;}
+
+        // --------------------------------------------------------------------
+        //! Add an input file
+        // --------------------------------------------------------------------
+        void AddInput(const std::string& input) {
+
+          m_inputs.push_back(input);
+          return;
+
+        }  // end 'AddInput(std::string&)'
+
+        // --------------------------------------------------------------------
+        //! Set no. of threads to merge with
+        // --------------------------------------------------------------------
+        void SetNThreads(const std::size_t nthreads) {
+
+          // inputs will be read in multiple threads
+          if (nthreads > 1) {
+            ROOT::EnableThreadSafety();
+          }
+          m_nthreads = (nthreads > 0) ? nthreads : 1;
+          return;
+
+        }  // end 'SetNThreads(std::size_t)'
+
+        // --------------------------------------------------------------------
+        //! List the histograms across all inputs
+        // --------------------------------------------------------------------
+        /*! Used when no list of histograms was provided. Every
+         *  input's keys are read (one file at a time), so that a
+         *  histogram is kept even if some jobs never filled it;
+         *  names are kept in order of first appearance. Definition
+         *  and index names can't be recovered from a file alone,
+         *  so only the full name is set (and histograms are
+         *  written to the top of the output).
+         */
+        void ListHistsFromInput() {
+
+          // throw error if no inputs
+          if (m_inputs.empty()) {
+            std::cerr << "PANIC: no inputs to list histograms from!" << std::endl;
+            assert(!m_inputs.empty());
+          }
+
+          TDirectory::TContext  context(nullptr);
+          std::set<std::string> seen;
+          std::size_t           nOpened = 0;
+          m_hists.clear();
+          for (const std::string& input : m_inputs) {
+
+            TFile* file = TFile::Open(input.data(), "read");
+            if (!file || file -> IsZombie()) {
+              std::cerr << "WARNING: couldn't open input '" << input << "', skipping." << std::endl;
+              delete file;
+              continue;
+            }
+            ++nOpened;
+
+            // keys are listed newest cycle first, so keep first of each name
+            for (TObject* object : *(file -> GetListOfKeys())) {
+              TKey*   key   = static_cast<TKey*>(object);
+              TClass* klass = TClass::GetClass( key -> GetClassName() );
+              if (!klass || !klass -> InheritsFrom( TH1::Class() )) continue;
+              if (!seen.insert( key -> GetName() ).second)           continue;
+
+              m_hists.push_back({"", "", key -> GetName()});
+            }
+            file -> Close();
+            delete file;
+          }
+
+          // throw error if nothing could be read
+          if (nOpened == 0) {
+            std::cerr << "PANIC: couldn't open any input to list histograms from!" << std::endl;
+            assert(nOpened > 0);
+          }
+          return;
+
+        }  // end 'ListHistsFromInput()'
+
+        // --------------------------------------------------------------------
+        //! Merge all inputs into an output file
+        // --------------------------------------------------------------------
+        /*! Histograms missing from every input are not
+         *  written. Any temporary files are removed once
+         *  they've been merged. Returns the no. of histograms
+         *  written.
+         */
+        std::size_t Merge(TFile* output) {
+
+          if (m_hists.empty()) {
+            std::cerr << "WARNING: no histograms set, listing them from the inputs. They'll be written to the top of the output." << std::endl;
+            ListHistsFromInput();
+          }
+
+          // threads are kept for the whole merge
+          MVA::WorkerPool workers(m_nthreads);
+
+          // merge groups into temporary files until
+          // the rest can be opened at once
+          std::vector<std::string> inputs = m_inputs;
+          std::vector<std::string> temps;
+          for (std::size_t level = 0; inputs.size() > m_max_open; ++level) {
+
+            std::vector<std::string> merged;
+            for (std::size_t start = 0; start < inputs.size(); start += m_max_open) {
+              const std::vector<std::string> group(
+                inputs.begin() + start,
+                inputs.begin() + std::min(start + m_max_open, inputs.size())
+              );
+
+              const std::string path = std::string(output -> GetName())
+                                     + ".part" + std::to_string(level)
+                                     + "_" + std::to_string(merged.size())
+                                     + ".root";
+              TFile* part = TFile::Open(path.data(), "recreate");
+              if (!part || part -> IsZombie()) {
+                std::cerr << "PANIC: couldn't create temporary file '" << path << "'!" << std::endl;
+                assert(part && !part -> IsZombie());
+              }
+              MergeGroup(workers, group, part, false);
+              part -> Close();
+              delete part;
+              merged.push_back(path);
+            }
+
+            // previous level's temporary files are no longer needed
+            for (const std::string& temp : temps) {
+              std::remove( temp.data() );
+            }
+            temps  = merged;
+            inputs = merged;
+          }
+
+          const std::size_t nWritten = MergeGroup(workers, inputs, output, true);
+          for (const std::string& temp : temps) {
+            std::remove( temp.data() );
+          }
+          return nWritten;
+
+        }  // end 'Merge(TFile*)'
+
+        // --------------------------------------------------------------------
+        //! Load the histograms of one definition from a merged file
+        // --------------------------------------------------------------------
+        /*! Only that definition's directory is read. If `select`
+         *  is given, only histograms it accepts are loaded. The
+         *  index of each name is recovered assuming the default
+         *  naming (see Manager::CreateHistName). Histograms are
+         *  owned by the caller.
+         */
+        static std::vector<TH1*> LoadSlice(
+          TFile* file,
+          const std::string& definition,
+          std::function<bool(const HistName&)> select = nullptr
+        ) {
+
+          std::vector<TH1*> hists;
+
+          TDirectory* dir = file -> GetDirectory( definition.data() );
+          if (!dir) {
+            std::cerr << "WARNING: no histograms for definition '" << definition << "' in '" << file -> GetName() << "'." << std::endl;
+            return hists;
+          }
+
+          std::set<std::string> seen;
+          const std::string     prefix = definition + "_";
+          for (TObject* object : *(dir -> GetListOfKeys())) {
+            const std::string name = object -> GetName();
+            if (!seen.insert(name).second) continue;
+
+            const bool  has_prefix = (name.compare(0, prefix.size(), prefix) == 0);
+            const HistName hist_name = {
+              definition,
+              has_prefix ? name.substr(prefix.size()) : "",
+              name
+            };
+            if (select && !select(hist_name)) continue;
+
+            TH1* hist = dynamic_cast<TH1*>( dir -> Get(name.data()) );
+            if (!hist) continue;
+
+            hist -> SetDirectory(nullptr);
+            hists.push_back(hist);
+          }
+          return hists;
+
+        }  // end 'LoadSlice(TFile*, std::string&, std::function<bool(HistName&)>)'
+
+        // --------------------------------------------------------------------
+        //! default ctor/dtor
+        // --------------------------------------------------------------------
+        Merger()  {};
+        ~Merger() {};
+
+        // --------------------------------------------------------------------
+        //! ctor accepting a list of inputs
+        // --------------------------------------------------------------------
+        Merger(const std::vector<std::string>& inputs) {
+          SetInputs(inputs);
+        }
+
+    };  // end Merger
+
+  }  // end Hist namespace
+}  // end ROOTAnalysisUtilities namespace
+
+#endif
+
+// end ========================================================================
@@ -15,12 +15,17 @@
 #include <cassert>
 #include <cmath>
 #include <optional>
+#include <utility>
 #include <vector>
 // root libraries
+#include <TArrayD.h>
+#include <TArrayF.h>
+#include <TAxis.h>
 #include <TH1.h>
 #include <TH2.h>
 #include <TMath.h>
 // rau componenets
+#include "../graph/GraphColumns.hxx"
 #include "../graph/GraphPoint.hxx"
 #include "HistTypes.hxx"
 
@@ -117,6 +122,54 @@ namespace ROOTAnalysisUtilities {
 
 
 
+    // ------------------------------------------------------------------------
+    //! Helper method to determine how a set of bin edges are spaced
+    // ------------------------------------------------------------------------
+    /*! Checks if edges are evenly spaced in linear or log space
+     *  (e.g. as produced by `GetBinEdges` or `GetBinEdgesLog`).
+     *  Edges are compared against the ideal ones to within a
+     *  small fraction of a bin, so the round-off accumulated
+     *  when generating edges doesn't matter.
+     */
+    Types::Spacing GetBinSpacing(const std::vector<double>& edges) {
+
+      // need at least one bin to say anything
+      if (edges.size() < 2) {
+        return Types::Spacing::Variable;
+      }
+
+      const std::size_t num   = edges.size() - 1;
+      const double      start = edges.front();
+      const double      stop  = edges.back();
+      const double      tol   = 1e-6;
+
+      // check for uniform spacing
+      const double step    = (stop - start) / num;
+      bool         uniform = true;
+      for (std::size_t iedge = 0; iedge < edges.size(); ++iedge) {
+        if (std::abs(edges[iedge] - (start + (iedge * step))) > (tol * step)) {
+          uniform = false;
+          break;
+        }
+      }
+      if (uniform) return Types::Spacing::Uniform;
+
+      // then check for log spacing
+      if (start <= 0.) return Types::Spacing::Variable;
+
+      const double log_step = (std::log(stop) - std::log(start)) / num;
+      for (std::size_t iedge = 0; iedge < edges.size(); ++iedge) {
+        const double log_edge = std::log(start) + (iedge * log_step);
+        if (std::abs(std::log(edges[iedge]) - log_edge) > (tol * log_step)) {
+          return Types::Spacing::Variable;
+        }
+      }
+      return Types::Spacing::Log;
+
+    }  // end 'GetBinSpacing(std::vector<double>&)'
+
+
+
     // ------------------------------------------------------------------------
     //! Helper method to extract bin edges from a vector of RAU::Graph::Point
     // ------------------------------------------------------------------------
@@ -167,7 +220,8 @@ namespace ROOTAnalysisUtilities {
     std::vector<Graph::Point> GetHistPoints(TH1* hist) {
 
       std::vector<Graph::Point> points;
-      for (std::size_t ibin = 1; ibin <= hist -> GetNbinsX(); ++ibin) {
+      points.reserve( hist -> GetNbinsX() );
+      for (Int_t ibin = 1; ibin <= hist -> GetNbinsX(); ++ibin) {
         points.emplace_back(
           hist -> GetBinCenter(ibin),
           hist -> GetBinContent(ibin),
@@ -187,8 +241,9 @@ namespace ROOTAnalysisUtilities {
     std::vector<Graph::Point> GetHistPoints(TH2* hist) {
 
       std::vector<Graph::Point> points;
-      for (std::size_t ibinx = 1; ibinx <= hist -> GetNbinsX(); ++ibinx) {
-        for (std::size_t ibiny = 1; ibiny <= hist -> GetNbinsY(); ++ibiny) {
+      points.reserve( hist -> GetNbinsX() * hist -> GetNbinsY() );
+      for (Int_t ibinx = 1; ibinx <= hist -> GetNbinsX(); ++ibinx) {
+        for (Int_t ibiny = 1; ibiny <= hist -> GetNbinsY(); ++ibiny) {
           points.emplace_back(
             hist -> GetXaxis() -> GetBinCenter(ibinx),
             hist -> GetYaxis() -> GetBinCenter(ibiny),
@@ -203,6 +258,177 @@ namespace ROOTAnalysisUtilities {
 
     }  // end 'GetHistPoints(TH2*)'
 
+
+
+    // ------------------------------------------------------------------------
+    //! Helper method to get the bin centers and widths of an axis
+    // ------------------------------------------------------------------------
+    /*! Reads the axis' edges directly, computing the
+     *  same values as TAxis::GetBinCenter and
+     *  TAxis::GetBinWidth.
+     */
+    void GetAxisCentersAndWidths(
+      const TAxis* axis,
+      std::vector<double>& centers,
+      std::vector<double>& widths
+    ) {
+
+      const std::size_t nbins = axis -> GetNbins();
+      centers.resize(nbins);
+      widths.resize(nbins);
+
+      // variable bins
+      const TArrayD* edges = axis -> GetXbins();
+      if (edges -> GetSize() > 0) {
+        const double* edge = edges -> GetArray();
+        for (std::size_t ibin = 0; ibin < nbins; ++ibin) {
+          widths[ibin]  = edge[ibin + 1] - edge[ibin];
+          centers[ibin] = edge[ibin] + (0.5 * widths[ibin]);
+        }
+        return;
+      }
+
+      // uniform bins
+      const double start = axis -> GetXmin();
+      const double width = (axis -> GetXmax() - start) / nbins;
+      for (std::size_t ibin = 0; ibin < nbins; ++ibin) {
+        widths[ibin]  = width;
+        centers[ibin] = start + (ibin * width) + (0.5 * width);
+      }
+      return;
+
+    }  // end 'GetAxisCentersAndWidths(TAxis*, std::vector<double>& x 2)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Helper method to read the cells of a histogram in bulk
+    // ------------------------------------------------------------------------
+    /*! Calls `read` with a function which maps a global bin
+     *  onto its (content, error). For plain TH*D and TH*F's
+     *  using normal errors, that function reads the content
+     *  and sum of squared weights arrays directly. Anything
+     *  else (e.g. profiles, Poisson errors) falls back to
+     *  GetBinContent/GetBinError.
+     */
+    template <typename R> auto ReadHistCells(TH1* hist, R read) {
+
+      hist -> BufferEmpty();
+
+      // sum of squared weights, if kept
+      const double* sumw2 = (hist -> GetSumw2N() > 0) ? hist -> GetSumw2() -> GetArray() : nullptr;
+      auto direct = [sumw2](const auto* content) {
+        return [content, sumw2](const std::size_t bin) {
+          const double value = content[bin];
+          const double error = sumw2 ? std::sqrt(sumw2[bin]) : std::sqrt(std::abs(value));
+          return std::make_pair(value, error);
+        };
+      };
+
+      const bool plain = (hist -> GetBinErrorOption() == TH1::kNormal)
+                      && !hist -> InheritsFrom("TProfile")
+                      && !hist -> InheritsFrom("TProfile2D");
+      if (plain) {
+        if (TArrayD* array = dynamic_cast<TArrayD*>(hist)) {
+          return read( direct(static_cast<const double*>(array -> GetArray())) );
+        }
+        if (TArrayF* array = dynamic_cast<TArrayF*>(hist)) {
+          return read( direct(static_cast<const float*>(array -> GetArray())) );
+        }
+      }
+
+      // otherwise go through the histogram
+      return read(
+        [hist](const std::size_t bin) {
+          return std::make_pair(hist -> GetBinContent(bin), hist -> GetBinError(bin));
+        }
+      );
+
+    }  // end 'ReadHistCells(TH1*, R)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Helper method to decompose a TH1 into RAU::Graph::Columns
+    // ------------------------------------------------------------------------
+    /*! Same points as `GetHistPoints(TH1*)`, but built column
+     *  by column straight from the histogram's arrays.
+     */
+    Graph::Columns GetHistColumns(TH1* hist) {
+
+      std::vector<double> centers;
+      std::vector<double> widths;
+      GetAxisCentersAndWidths(hist -> GetXaxis(), centers, widths);
+
+      auto fill = [&centers, &widths](auto cell) {
+
+        Graph::Columns columns;
+        columns.Resize( centers.size() );
+        for (std::size_t ibin = 0; ibin < centers.size(); ++ibin) {
+          const auto value = cell(ibin + 1);
+          columns.x[ibin]     = centers[ibin];
+          columns.y[ibin]     = value.first;
+          columns.ex[ibin]    = widths[ibin];
+          columns.ex_lo[ibin] = widths[ibin] / 2.;
+          columns.ex_hi[ibin] = widths[ibin] / 2.;
+          columns.ey[ibin]    = value.second;
+          columns.ey_lo[ibin] = value.second / 2.;
+          columns.ey_hi[ibin] = value.second / 2.;
+        }
+        return columns;
+      };
+      return ReadHistCells(hist, fill);
+
+    }  // end 'GetHistColumns(TH1*)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Helper method to decompose a TH2 into RAU::Graph::Columns
+    // ------------------------------------------------------------------------
+    /*! Same points, in the same order, as `GetHistPoints(TH2*)`,
+     *  but built column by column straight from the histogram's
+     *  arrays.
+     */
+    Graph::Columns GetHistColumns(TH2* hist) {
+
+      std::vector<double> xcenters;
+      std::vector<double> xwidths;
+      std::vector<double> ycenters;
+      std::vector<double> ywidths;
+      GetAxisCentersAndWidths(hist -> GetXaxis(), xcenters, xwidths);
+      GetAxisCentersAndWidths(hist -> GetYaxis(), ycenters, ywidths);
+
+      const std::size_t nx = xcenters.size();
+      const std::size_t ny = ycenters.size();
+      auto fill = [&](auto cell) {
+
+        Graph::Columns columns;
+        columns.Resize(nx * ny);
+        for (std::size_t ibinx = 0; ibinx < nx; ++ibinx) {
+          for (std::size_t ibiny = 0; ibiny < ny; ++ibiny) {
+            const std::size_t ipoint = (ibinx * ny) + ibiny;
+            const auto        value  = cell( (ibinx + 1) + ((nx + 2) * (ibiny + 1)) );
+            columns.x[ipoint]     = xcenters[ibinx];
+            columns.y[ipoint]     = ycenters[ibiny];
+            columns.z[ipoint]     = value.first;
+            columns.ex[ipoint]    = xwidths[ibinx];
+            columns.ex_lo[ipoint] = xwidths[ibinx] / 2.;
+            columns.ex_hi[ipoint] = xwidths[ibinx] / 2.;
+            columns.ey[ipoint]    = ywidths[ibiny];
+            columns.ey_lo[ipoint] = ywidths[ibiny] / 2.;
+            columns.ey_hi[ipoint] = ywidths[ibiny] / 2.;
+            columns.ez[ipoint]    = value.second;
+            columns.ez_lo[ipoint] = value.second / 2.;
+            columns.ez_hi[ipoint] = value.second / 2.;
+          }
+        }
+        return columns;
+      };
+      return ReadHistCells(hist, fill);
+
+    }  // end 'GetHistColumns(TH2*)'
+
   }  // end Tools namespace
 }  // end ROOTAnalysisUtilities namespace
 
@@ -20,6 +20,26 @@ namespace ROOTAnalysisUtilities {
     // ------------------------------------------------------------------------
     enum Axis {X, Y, Z};
 
+
+
+    // ------------------------------------------------------------------------
+    //! Different ways of storing a grid of histograms
+    // ------------------------------------------------------------------------
+    /*! Grid: map of index to named histograms, all of
+     *        which are built up front
+     *  Flat: dense array of histograms addressed by
+     *        (linear index, definition handle), each
+     *        built on first fill
+     */
+    enum class Storage {Grid, Flat};
+
+
+
+    // ------------------------------------------------------------------------
+    //! Different ways bin edges can be spaced
+    // ------------------------------------------------------------------------
+    enum class Spacing {Uniform, Log, Variable};
+
   }  // end Types namespace
 }  // end ROOTAnalysisUtilities namespace
 
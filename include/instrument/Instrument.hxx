@@ -0,0 +1,21 @@
+/// ===========================================================================
+/*! \file   Instrument.hxx
+ *  \author Derek Anderson
+ *  \date   10.16.2026
+ *
+ *  RAU components to count and time what the
+ *  library does.
+ */
+/// ===========================================================================
+
+#ifndef RAU_INSTRUMENT_HXX
+#define RAU_INSTRUMENT_HXX
+
+// components
+#include "InstrumentMacros.hxx"
+#include "InstrumentRegistry.hxx"
+#include "InstrumentTimer.hxx"
+
+#endif
+
+// end ========================================================================
@@ -0,0 +1,58 @@
+/// ===========================================================================
+/*! \file   InstrumentMacros.hxx
+ *  \author Derek Anderson
+ *  \date   10.16.2026
+ *
+ *  Macros to instrument code, which are compiled out
+ *  unless RAU_INSTRUMENT is defined.
+ *
+ *    RAU_COUNT(name, n)       add n to counter "name"
+ *    RAU_TIME_SCOPE(name)     time the rest of the scope under "name"
+ *    RAU_INSTRUMENT_DUMP()    print all counters and timers
+ *
+ *  Names should be string literals: each use looks its
+ *  counter/timer up once and holds onto it.
+ */
+/// ===========================================================================
+
+#ifndef RAU_INSTRUMENTMACROS_HXX
+#define RAU_INSTRUMENTMACROS_HXX
+
+#ifdef RAU_INSTRUMENT
+
+// rau components
+#include "InstrumentRegistry.hxx"
+#include "InstrumentTimer.hxx"
+
+// helpers to make unique variable names
+#define RAU_INSTRUMENT_CAT_IMPL(a, b) a##b
+#define RAU_INSTRUMENT_CAT(a, b)      RAU_INSTRUMENT_CAT_IMPL(a, b)
+
+#define RAU_COUNT(name, n) \
+  do { \
+    static ::ROOTAnalysisUtilities::Instrument::Counter& rau_counter = \
+      ::ROOTAnalysisUtilities::Instrument::Registry::Get().GetCounter(name); \
+    rau_counter.Add(n); \
+  } while (0)
+
+#define RAU_TIME_SCOPE(name) \
+  static ::ROOTAnalysisUtilities::Instrument::Timer& RAU_INSTRUMENT_CAT(rau_timer_, __LINE__) = \
+    ::ROOTAnalysisUtilities::Instrument::Registry::Get().GetTimer(name); \
+  ::ROOTAnalysisUtilities::Instrument::ScopedTimer RAU_INSTRUMENT_CAT(rau_scope_, __LINE__)( \
+    RAU_INSTRUMENT_CAT(rau_timer_, __LINE__) \
+  )
+
+#define RAU_INSTRUMENT_DUMP() \
+  ::ROOTAnalysisUtilities::Instrument::Registry::Get().Dump()
+
+#else
+
+#define RAU_COUNT(name, n)    do {} while (0)
+#define RAU_TIME_SCOPE(name)  do {} while (0)
+#define RAU_INSTRUMENT_DUMP() do {} while (0)
+
+#endif
+
+#endif
+
+// end ========================================================================
@@ -0,0 +1,196 @@
+/// ===========================================================================
+/*! \file   InstrumentRegistry.hxx
+ *  \author Derek Anderson
+ *  \date   10.16.2026
+ *
+ *  Registry of named counters and timers.
+ */
+/// ===========================================================================
+
+#ifndef RAU_INSTRUMENTREGISTRY_HXX
+#define RAU_INSTRUMENTREGISTRY_HXX
+
+// c++ utilities
+#include <atomic>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+
+
+namespace ROOTAnalysisUtilities {
+  namespace Instrument {
+
+    // ========================================================================
+    //! Counter
+    // ========================================================================
+    /*! A named count (of fills, lookups, bytes, etc.)
+     *  which can be added to from any thread.
+     */
+    struct Counter {
+
+      std::atomic<uint64_t> count{0};  ///!< running total
+
+      // ----------------------------------------------------------------------
+      //! Add to count
+      // ----------------------------------------------------------------------
+      void Add(const uint64_t n) {count.fetch_add(n, std::memory_order_relaxed);}
+
+    };  // end Counter
+
+    // ========================================================================
+    //! Timer
+    // ========================================================================
+    /*! A named accumulation of time spent in a
+     *  block of code, and how often it was entered.
+     */
+    struct Timer {
+
+      std::atomic<uint64_t> calls{0};  ///!< no. of times block was timed
+      std::atomic<uint64_t> nanos{0};  ///!< total time spent in block
+
+      // ----------------------------------------------------------------------
+      //! Add a timed call
+      // ----------------------------------------------------------------------
+      void Add(const uint64_t ns) {
+        calls.fetch_add(1, std::memory_order_relaxed);
+        nanos.fetch_add(ns, std::memory_order_relaxed);
+      }
+
+    };  // end Timer
+
+    // ========================================================================
+    //! Registry
+    // ========================================================================
+    /*! A single, process-wide place to look up counters and
+     *  timers by name. Looking up takes a lock, but counters
+     *  and timers never move once made, so a reference to one
+     *  can be held onto and used freely afterwards (which is
+     *  what the RAU_COUNT and RAU_TIME_SCOPE macros do).
+     */
+    class Registry {
+
+      private:
+
+        // members
+        bool                                            m_dump_at_exit = false;
+        std::mutex                                      m_mutex;
+        std::map<std::string, std::unique_ptr<Counter>> m_counters;
+        std::map<std::string, std::unique_ptr<Timer>>   m_timers;
+
+        // --------------------------------------------------------------------
+        //! default ctor/dtor
+        // --------------------------------------------------------------------
+        /*! If asked, dumps everything when the
+         *  process exits.
+         */
+        Registry()  {};
+        ~Registry() {
+          if (m_dump_at_exit) Dump();
+        };
+
+      public:
+
+        // --------------------------------------------------------------------
+        //! Get the registry
+        // --------------------------------------------------------------------
+        static Registry& Get() {
+
+          static Registry registry;
+          return registry;
+
+        }  // end 'Get()'
+
+        // --------------------------------------------------------------------
+        //! Turn on/off dumping at exit
+        // --------------------------------------------------------------------
+        void SetDumpAtExit(const bool dump) {m_dump_at_exit = dump;}
+
+        // --------------------------------------------------------------------
+        //! Get a counter, making it if need be
+        // --------------------------------------------------------------------
+        Counter& GetCounter(const std::string& name) {
+
+          std::lock_guard<std::mutex> lock(m_mutex);
+          auto& counter = m_counters[name];
+          if (!counter) counter = std::make_unique<Counter>();
+          return *counter;
+
+        }  // end 'GetCounter(std::string&)'
+
+        // --------------------------------------------------------------------
+        //! Get a timer, making it if need be
+        // --------------------------------------------------------------------
+        Timer& GetTimer(const std::string& name) {
+
+          std::lock_guard<std::mutex> lock(m_mutex);
+          auto& timer = m_timers[name];
+          if (!timer) timer = std::make_unique<Timer>();
+          return *timer;
+
+        }  // end 'GetTimer(std::string&)'
+
+        // --------------------------------------------------------------------
+        //! Zero all counters and timers
+        // --------------------------------------------------------------------
+        void Reset() {
+
+          std::lock_guard<std::mutex> lock(m_mutex);
+          for (auto& counter : m_counters) {
+            counter.second -> count = 0;
+          }
+          for (auto& timer : m_timers) {
+            timer.second -> calls = 0;
+            timer.second -> nanos = 0;
+          }
+          return;
+
+        }  // end 'Reset()'
+
+        // --------------------------------------------------------------------
+        //! Print all counters and timers
+        // --------------------------------------------------------------------
+        void Dump(std::ostream& out = std::cout) {
+
+          std::lock_guard<std::mutex> lock(m_mutex);
+          out << "\n -------------------------------- \n"
+              << "  Instrumentation:\n"
+              << "    Counters:"
+              << std::endl;
+          for (const auto& counter : m_counters) {
+            out << "      " << std::left << std::setw(32) << counter.first
+                << counter.second -> count
+                << std::endl;
+          }
+
+          out << "    Timers:" << std::endl;
+          for (const auto& timer : m_timers) {
+            const uint64_t calls = timer.second -> calls;
+            const double   msec  = timer.second -> nanos * 1e-6;
+            out << "      " << std::left << std::setw(32) << timer.first
+                << calls << " calls, "
+                << msec << " ms total, "
+                << (calls > 0 ? msec / calls : 0.) << " ms/call"
+                << std::endl;
+          }
+          out << " -------------------------------- \n" << std::endl;
+          return;
+
+        }  // end 'Dump(std::ostream&)'
+
+        // no copying
+        Registry(const Registry&)            = delete;
+        Registry& operator=(const Registry&) = delete;
+
+    };  // end Registry
+
+  }  // end Instrument namespace
+}  // end ROOTAnalysisUtilities namespace
+
+#endif
+
+// end ========================================================================
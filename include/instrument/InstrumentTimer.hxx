@@ -0,0 +1,65 @@
+/// ===========================================================================
+/*! \file   InstrumentTimer.hxx
+ *  \author Derek Anderson
+ *  \date   10.16.2026
+ *
+ *  Timer for a scope.
+ */
+/// ===========================================================================
+
+#ifndef RAU_INSTRUMENTTIMER_HXX
+#define RAU_INSTRUMENTTIMER_HXX
+
+// c++ utilities
+#include <chrono>
+// rau components
+#include "InstrumentRegistry.hxx"
+
+
+
+namespace ROOTAnalysisUtilities {
+  namespace Instrument {
+
+    // ========================================================================
+    //! Scoped timer
+    // ========================================================================
+    /*! Adds the time between its construction and
+     *  destruction to a Timer.
+     */
+    class ScopedTimer {
+
+      private:
+
+        // members
+        Timer&                                m_timer;
+        std::chrono::steady_clock::time_point m_start;
+
+      public:
+
+        // --------------------------------------------------------------------
+        //! ctor accepting a timer
+        // --------------------------------------------------------------------
+        ScopedTimer(Timer& timer) : m_timer(timer) {
+          m_start = std::chrono::steady_clock::now();
+        };
+
+        // --------------------------------------------------------------------
+        //! dtor
+        // --------------------------------------------------------------------
+        ~ScopedTimer() {
+          const auto elapsed = std::chrono::steady_clock::now() - m_start;
+          m_timer.Add( std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() );
+        };
+
+        // no copying
+        ScopedTimer(const ScopedTimer&)            = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    };  // end ScopedTimer
+
+  }  // end Instrument namespace
+}  // end ROOTAnalysisUtilities namespace
+
+#endif
+
+// end ========================================================================
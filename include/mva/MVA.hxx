@@ -17,7 +17,9 @@
 #include "MVAReadHelper.hxx"
 #include "MVATools.hxx"
 #include "MVATrainHelper.hxx"
+#include "MVATrainScheduler.hxx"
 #include "MVATypes.hxx"
+#include "MVAWorkerPool.hxx"
 
 #endif
 
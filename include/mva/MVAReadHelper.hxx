@@ -11,18 +11,26 @@
 #define RAU_MVAREADHELPER_hxx
 
 // c++ utilities
+#include <algorithm>
+#include <cassert>
+#include <limits>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 // root libraries
+#include <TROOT.h>
 #include <TString.h>
 // tmva components
 #include <TMVA/Reader.h>
 // rau components
+#include "../instrument/InstrumentMacros.hxx"
 #include "../ntuple/NTupleHelper.hxx"
+#include "../ntuple/NTupleReader.hxx"
 #include "MVABaseHelper.hxx"
 #include "MVATools.hxx"
 #include "MVATypes.hxx"
+#include "MVAWorkerPool.hxx"
 
 
 
@@ -35,6 +43,12 @@ namespace ROOTAnalysisUtilities {
     /*! A small class to help reading/evaluating
      *  modles via ROOT TMVA.
      *
+     *  Methods can either be evaluated one event at a time
+     *  with a user-provided reader (`EvaluateMethods`), or
+     *  a whole block of events at once (`EvaluateBlock`)
+     *  with a pool of readers owned by the helper, one per
+     *  thread (see `BookReaderPool`).
+     *
      *  FIXME integrating the helpers w/ the parameters
      *  more tightly might make things cleaner...
      */
@@ -49,28 +63,53 @@ namespace ROOTAnalysisUtilities {
         std::vector<std::string>           m_options;
         std::map<std::string, std::size_t> m_outdex;
 
+        // precomputed method titles and output positions
+        std::vector<TString>                  m_titles;
+        std::vector<std::size_t>              m_target_slots;
+        std::vector<std::vector<std::size_t>> m_output_slots;
+
+        // min. no. of entries worth handing to another thread
+        static constexpr std::size_t m_min_per_reader = 256;
+
+        // pool of readers, their inputs, and the threads using them
+        std::vector<std::unique_ptr<TMVA::Reader>> m_pool;
+        std::vector<std::vector<float>>            m_pool_inputs;
+        std::unique_ptr<WorkerPool>                m_workers;
+
         // ----------------------------------------------------------------------
         //! Generate list of regression outputs
         // ----------------------------------------------------------------------
         /*! Will generate list of targets and the regression
          *  outputs. Every specified target will be evaluated
-         *  for every specified method.
+         *  for every specified method. Any previous list is
+         *  replaced.
          */
         inline void GenerateRegressionOutputs() {
 
+          // clear any previous outputs
+          m_outvars.clear();
+          m_outdex.clear();
+          m_titles.clear();
+          m_target_slots.clear();
+          m_output_slots.clear();
+
           // first load targets
           std::size_t iOut = 0;
           for (const std::string& target : m_targets) {
             m_outvars.push_back( target );
             m_outdex[ m_outvars.back() ] = iOut;
+            m_target_slots.push_back( iOut );
             ++iOut;
           }
 
           // then generate list of regression outputs
           for (const std::string& method : m_methods) {
+            m_titles.emplace_back( method + " method" );
+            m_output_slots.emplace_back();
             for (const std::string& target : m_targets) {
               m_outvars.push_back( target + "_" + method );
               m_outdex[ m_outvars.back() ] = iOut;
+              m_output_slots.back().push_back( iOut );
               ++iOut;
             }
           }
@@ -81,6 +120,32 @@ namespace ROOTAnalysisUtilities {
 
         }  // end 'GenerateRegressionOutputs()'
 
+        // ----------------------------------------------------------------------
+        //! Create pool of readers
+        // ----------------------------------------------------------------------
+        /*! Each reader gets its own copy of the inputs so
+         *  they can be evaluated independently.
+         */
+        inline void MakeReaderPool(const std::size_t nreaders) {
+
+          // readers will be used in multiple threads
+          if (nreaders > 1) {
+            ROOT::EnableThreadSafety();
+          }
+
+          m_pool.clear();
+          m_workers = std::make_unique<WorkerPool>(nreaders);
+          m_pool_inputs.assign( std::max<std::size_t>(nreaders, 1), std::vector<float>(m_trainers.size(), 0.) );
+          for (auto& inputs : m_pool_inputs) {
+            m_pool.emplace_back( new TMVA::Reader(CompressOptions()) );
+            for (std::size_t iTrain = 0; iTrain < m_trainers.size(); ++iTrain) {
+              m_pool.back() -> AddVariable( m_trainers[iTrain].data(), &inputs[iTrain] );
+            }
+          }
+          return;
+
+        }  // end 'MakeReaderPool(std::size_t)'
+
       public:
 
         // ----------------------------------------------------------------------
@@ -229,6 +294,8 @@ namespace ROOTAnalysisUtilities {
         // ----------------------------------------------------------------------
         inline void EvaluateMethods(TMVA::Reader* reader, NTupleHelper& helper) {
 
+          RAU_COUNT("mva.events_evaluated", 1);
+
           // loop over all methods
           for (std::size_t iMethod = 0; iMethod < m_methods.size(); ++iMethod) {
 
@@ -237,25 +304,143 @@ namespace ROOTAnalysisUtilities {
               continue;
             }
 
-            // construct title & run evaluation
-            const std::string        title   = m_methods[iMethod] + " method";
-            const std::vector<float> targets = reader -> EvaluateRegression(title);
+            // run evaluation
+            const std::vector<float>& targets = reader -> EvaluateRegression( m_titles[iMethod] );
 
             // collect regression output
             for (std::size_t iTarget = 0; iTarget < m_targets.size(); ++iTarget) {
-              const std::string output = m_targets[iTarget] + "_" + m_methods[iMethod];
-              m_outvals.at(m_outdex[output]) = targets.at(iTarget);
+              m_outvals[ m_output_slots[iMethod][iTarget] ] = targets.at(iTarget);
             }
           }  // end method loop
 
           // then collect training targets in output
-          for (const std::string& target : m_targets) {
-            m_outvals.at(m_outdex[target]) = helper.GetVariable( target );
+          for (std::size_t iTarget = 0; iTarget < m_targets.size(); ++iTarget) {
+            m_outvals[ m_target_slots[iTarget] ] = helper.GetVariable( m_targets[iTarget] );
           }
           return;
 
         }  // end 'EvaluateMethods(TMVA::Reader*, NTupleHelper&)'
 
+        // ----------------------------------------------------------------------
+        //! Create a pool of readers by providing the path to a directory
+        // ----------------------------------------------------------------------
+        /*! Creates one reader per thread to be used by `EvaluateBlock`,
+         *  and books methods for each as in `BookMethodsToRead`. All
+         *  training variables are added to each reader.
+         */
+        inline void BookReaderPool(
+          const std::size_t nreaders,
+          const std::string& directory,
+          const std::string& name
+        ) {
+
+          MakeReaderPool(nreaders);
+          for (auto& reader : m_pool) {
+            BookMethodsToRead(reader.get(), directory, name);
+          }
+          return;
+
+        }  // end 'BookReaderPool(std::size_t, std::string&, std::string&)'
+
+        // ----------------------------------------------------------------------
+        //! Create a pool of readers by providing a list of weight files
+        // ----------------------------------------------------------------------
+        inline void BookReaderPool(
+          const std::size_t nreaders,
+          const std::vector<std::string>& files
+        ) {
+
+          MakeReaderPool(nreaders);
+          for (auto& reader : m_pool) {
+            BookMethodsToRead(reader.get(), files);
+          }
+          return;
+
+        }  // end 'BookReaderPool(std::size_t, std::vector<std::string>&)'
+
+        // ----------------------------------------------------------------------
+        //! Evaluate all booked methods for a block of events
+        // ----------------------------------------------------------------------
+        /*! Evaluates every entry of the current block of `block` using
+         *  the pool of readers, splitting entries evenly between them
+         *  (and so between the pool's threads, which persist between
+         *  calls). Small blocks use fewer readers. `outputs` is filled with one
+         *  column per output, in the same order as `GetOutputs`.
+         *  Values are identical to those from `EvaluateMethods`, and
+         *  outputs of methods which weren't booked are left at their
+         *  reset value.
+         */
+        inline void EvaluateBlock(
+          const NTupleReader& block,
+          std::vector<std::vector<float>>& outputs
+        ) {
+
+          // throw error if pool wasn't booked
+          if (m_pool.empty()) {
+            std::cerr << "PANIC: reader pool must be booked before evaluating a block!" << std::endl;
+            assert(!m_pool.empty());
+          }
+
+          RAU_TIME_SCOPE("mva.evaluate_block");
+          RAU_COUNT("mva.events_evaluated", block.GetSize());
+
+          // resolve input columns
+          std::vector<std::size_t> trainCols;
+          for (const std::string& train : m_trainers) {
+            trainCols.push_back( block.GetColumn(train) );
+          }
+
+          // prepare outputs and copy targets
+          const std::size_t nEntries = block.GetSize();
+          outputs.resize( m_outvars.size() );
+          for (auto& output : outputs) {
+            output.assign( nEntries, -1. * std::numeric_limits<float>::max() );
+          }
+          for (std::size_t iTarget = 0; iTarget < m_targets.size(); ++iTarget) {
+            outputs[ m_target_slots[iTarget] ] = block.GetValues( block.GetColumn(m_targets[iTarget]) );
+          }
+
+          // evaluate a range of entries with a given reader
+          auto evaluate = [&](const std::size_t iReader, const std::size_t start, const std::size_t stop) {
+
+            TMVA::Reader*       reader = m_pool[iReader].get();
+            std::vector<float>& inputs = m_pool_inputs[iReader];
+            for (std::size_t iEntry = start; iEntry < stop; ++iEntry) {
+
+              for (std::size_t iTrain = 0; iTrain < trainCols.size(); ++iTrain) {
+                inputs[iTrain] = block.GetData( trainCols[iTrain] )[iEntry];
+              }
+
+              for (std::size_t iMethod = 0; iMethod < m_methods.size(); ++iMethod) {
+                if (!m_read[iMethod]) continue;
+
+                const std::vector<float>& targets = reader -> EvaluateRegression( m_titles[iMethod] );
+                for (std::size_t iTarget = 0; iTarget < m_targets.size(); ++iTarget) {
+                  outputs[ m_output_slots[iMethod][iTarget] ][iEntry] = targets.at(iTarget);
+                }
+              }
+            }  // end entry loop
+          };
+
+          // split entries between readers, so long as each
+          // gets enough to be worth waking a thread for
+          const std::size_t nReaders = std::max<std::size_t>(
+            std::min(m_pool.size(), nEntries / m_min_per_reader),
+            1
+          );
+          const std::size_t nPer = (nEntries + nReaders - 1) / nReaders;
+          m_workers -> Run(
+            nReaders,
+            [&](const std::size_t iReader) {
+              const std::size_t start = std::min(iReader * nPer, nEntries);
+              const std::size_t stop  = std::min(start + nPer, nEntries);
+              evaluate(iReader, start, stop);
+            }
+          );
+          return;
+
+        }  // end 'EvaluateBlock(NTupleReader&, std::vector<std::vector<float>>&)'
+
         // ----------------------------------------------------------------------
         //! Default ctor/dtor
         // ----------------------------------------------------------------------
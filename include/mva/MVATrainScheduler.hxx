@@ -0,0 +1,504 @@
+/// ===========================================================================
+/*! \file   MVATrainScheduler.hxx
+ *  \author Derek Anderson
+ *  \date   10.16.2026
+ *
+ *  Driver for training many TMVA methods in parallel.
+ */
+/// ===========================================================================
+
+#ifndef RAU_MVATRAINSCHEDULER_hxx
+#define RAU_MVATRAINSCHEDULER_hxx
+
+// c++ utilities
+#include <cassert>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+// root libraries
+#include <ROOT/TProcessExecutor.hxx>
+#include <ROOT/TSeq.hxx>
+#include <TChain.h>
+#include <TCut.h>
+#include <TFile.h>
+#include <TLeaf.h>
+#include <TNamed.h>
+#include <TTree.h>
+#include <TTreeFormula.h>
+// tmva components
+#include <TMVA/DataLoader.h>
+#include <TMVA/Factory.h>
+#include <TMVA/MethodBase.h>
+#include <TMVA/Types.h>
+// rau components
+#include "MVAParameters.hxx"
+#include "MVATools.hxx"
+#include "MVATrainHelper.hxx"
+#include "MVATypes.hxx"
+
+
+
+namespace ROOTAnalysisUtilities {
+  namespace MVA {
+
+    // ==========================================================================
+    //! Training Scheduler
+    // ==========================================================================
+    /*! A small class to train many methods (or many variants
+     *  of the same method) at once. The input tree is skimmed
+     *  once into a compact local cache, keeping only the
+     *  variables and entries needed for training, and every
+     *  job then trains one method off of that cache in its own
+     *  worker process (TMVA factories can't be safely run in
+     *  parallel within one process).
+     *
+     *  Each job writes its weights to
+     *    "<directory>/weights/<name>_<job>.weights.xml"
+     *  which is the layout ReadHelper::BookMethodsToRead expects,
+     *  and its TMVA output to "<directory>/<name>_<job>.root".
+     *  A summary of each job's timing and regression deviation
+     *  (of the first target, on the test sample) is written to
+     *  "<directory>/<name>_summary.txt".
+     */
+    class TrainScheduler {
+
+      public:
+
+        // ======================================================================
+        //! Training job
+        // ======================================================================
+        /*! A small struct to consolidate what defines a
+         *  single method to be trained.
+         */
+        struct Job {
+          std::string name;     ///!< name of method, used for weight file
+          std::string type;     ///!< which algorithm to use (see Tools::MapNameToType)
+          std::string options;  ///!< method options
+        };
+
+        // ======================================================================
+        //! Result of a training job
+        // ======================================================================
+        struct Result {
+          bool   trained   = false;  ///!< whether or not job succeeded
+          double seconds   = -1.;    ///!< wall time of job
+          double deviation = -1.;    ///!< std. dev. of first target on test sample
+          double dev90     = -1.;    ///!< same, but truncated to 90% of events
+        };
+
+      private:
+
+        // data members
+        bool                m_add_watchers = false;
+        float               m_weight       = 1.;
+        TCut                m_cuts;
+        std::string         m_directory;
+        std::string         m_name;
+        std::string         m_cache;
+        std::string         m_cache_tree;
+        TrainHelper         m_helper;
+        std::vector<Job>    m_jobs;
+        std::vector<Result> m_results;
+
+        // ----------------------------------------------------------------------
+        //! Get all expressions needed to train
+        // ----------------------------------------------------------------------
+        /*! I.e. targets, training variables, spectators (if
+         *  needed), and cuts.
+         */
+        inline std::vector<std::string> GetExpressions() const {
+
+          std::vector<std::string> exprs = m_helper.GetTargets();
+          for (const std::string& var : m_helper.GetTrainers()) exprs.push_back(var);
+          if (m_add_watchers) {
+            for (const std::string& var : m_helper.GetSpectators()) exprs.push_back(var);
+          }
+          if (std::string(m_cuts.GetTitle()) != "") {
+            exprs.push_back( m_cuts.GetTitle() );
+          }
+          return exprs;
+
+        }  // end 'GetExpressions()'
+
+        // ----------------------------------------------------------------------
+        //! Get signature of what a sample cache holds
+        // ----------------------------------------------------------------------
+        /*! Covers the input (its file(s) and no. of entries) as
+         *  well as what's read from it, so that a cache isn't
+         *  reused once the input is regenerated. A single file is
+         *  identified by its UUID and modification date, and the
+         *  files of a chain by their paths.
+         */
+        inline std::string GetCacheSignature(const TTree* tree) const {
+
+          std::string signature = std::string("tree=") + tree -> GetName();
+          signature += ";files=";
+          const TChain* chain = dynamic_cast<const TChain*>(tree);
+          if (chain) {
+            for (TObject* element : *(chain -> GetListOfFiles())) {
+              signature += std::string(element -> GetTitle()) + ",";
+            }
+          } else if (tree -> GetCurrentFile()) {
+            const TFile* file = tree -> GetCurrentFile();
+            signature += std::string(file -> GetName())
+                       + "," + file -> GetUUID().AsString()
+                       + "," + file -> GetModificationDate().AsSQLString();
+          }
+          signature += ";entries=" + std::to_string( tree -> GetEntries() );
+          signature += ";targets=";
+          for (const std::string& var : m_helper.GetTargets())  signature += var + ",";
+          signature += ";trainers=";
+          for (const std::string& var : m_helper.GetTrainers()) signature += var + ",";
+          signature += ";spectators=";
+          if (m_add_watchers) {
+            for (const std::string& var : m_helper.GetSpectators()) signature += var + ",";
+          }
+          signature += std::string(";cuts=") + m_cuts.GetTitle();
+          return signature;
+
+        }  // end 'GetCacheSignature(TTree*)'
+
+        // ----------------------------------------------------------------------
+        //! Check if an existing cache matches what's needed
+        // ----------------------------------------------------------------------
+        inline bool IsCacheValid(const std::string& path, const std::string& signature) const {
+
+          if (!Tools::DoesFileExist(path)) return false;
+
+          TFile* cache = TFile::Open( path.data(), "read" );
+          if (!cache || cache -> IsZombie()) {
+            delete cache;
+            return false;
+          }
+
+          TNamed*    stored = dynamic_cast<TNamed*>( cache -> Get("signature") );
+          const bool valid  = stored && (signature == stored -> GetTitle());
+          cache -> Close();
+          delete cache;
+          return valid;
+
+        }  // end 'IsCacheValid(std::string&, std::string&)'
+
+        // ----------------------------------------------------------------------
+        //! Get branches an expression reads
+        // ----------------------------------------------------------------------
+        /*! Expressions can be formulas of branches (e.g.
+         *  "log(x)" or "x*y"), so the leaves they use are
+         *  found by compiling them with a TTreeFormula.
+         */
+        inline std::set<std::string> GetBranchesUsed(TTree* tree, const std::string& expr) const {
+
+          TTreeFormula formula("rau_cache_formula", expr.data(), tree);
+          if (formula.GetNdim() == 0) {
+            std::cerr << "PANIC: couldn't compile '" << expr << "' against input tree!" << std::endl;
+            assert(formula.GetNdim() > 0);
+          }
+
+          std::set<std::string> branches;
+          for (Int_t iCode = 0; iCode < formula.GetNcodes(); ++iCode) {
+            TLeaf* leaf = formula.GetLeaf(iCode);
+            if (!leaf) continue;
+
+            // make sure parents of split branches are read too
+            branches.insert( leaf -> GetBranch() -> GetName() );
+            branches.insert( leaf -> GetBranch() -> GetMother() -> GetName() );
+          }
+          return branches;
+
+        }  // end 'GetBranchesUsed(TTree*, std::string&)'
+
+        // ----------------------------------------------------------------------
+        //! Train a single job
+        // ----------------------------------------------------------------------
+        /*! Run inside of a worker process. Returns the job's
+         *  result as {trained, seconds, deviation, dev90}.
+         */
+        inline std::vector<double> RunJob(const Job& job) {
+
+          const auto start = std::chrono::steady_clock::now();
+
+          // open cached samples
+          TFile* input = TFile::Open( m_cache.data(), "read" );
+          if (!input || input -> IsZombie()) {
+            std::cerr << "WARNING: couldn't open sample cache '" << m_cache << "'! Not training '" << job.name << "'!" << std::endl;
+            return {0., -1., -1., -1.};
+          }
+          TTree* tree = dynamic_cast<TTree*>( input -> Get( m_cache_tree.data() ) );
+          if (!tree) {
+            std::cerr << "WARNING: no tree '" << m_cache_tree << "' in sample cache '" << m_cache << "'! Not training '" << job.name << "'!" << std::endl;
+            input -> Close();
+            return {0., -1., -1., -1.};
+          }
+
+          // set up factory and data loader
+          const std::string path   = m_directory + "/" + m_name + "_" + job.name + ".root";
+          TFile*            output = TFile::Open( path.data(), "recreate" );
+          if (!output || output -> IsZombie()) {
+            std::cerr << "WARNING: couldn't create output '" << path << "'! Not training '" << job.name << "'!" << std::endl;
+            input -> Close();
+            return {0., -1., -1., -1.};
+          }
+
+          TMVA::Factory*    factory = new TMVA::Factory( m_name, output, m_helper.CompressFactoryOptions() );
+          TMVA::DataLoader* loader  = new TMVA::DataLoader( m_directory );
+          m_helper.LoadVariables(loader, m_add_watchers);
+          loader -> AddRegressionTree(tree, m_weight);
+          loader -> PrepareTrainingAndTestTree( TCut(""), m_helper.CompressTrainingOptions() );
+
+          // train, test, and evaluate method
+          factory -> BookMethod(
+            loader,
+            Tools::MapNameToType().at(job.type),
+            job.name.data(),
+            job.options.data()
+          );
+          factory -> TrainAllMethods();
+          factory -> TestAllMethods();
+          factory -> EvaluateAllMethods();
+
+          // grab deviation on test sample
+          double deviation = -1.;
+          double dev90     = -1.;
+          TMVA::MethodBase* method = dynamic_cast<TMVA::MethodBase*>( factory -> GetMethod(m_directory, job.name) );
+          if (method) {
+            method -> GetRegressionDeviation(0, TMVA::Types::kTesting, deviation, dev90);
+          }
+
+          // clean up
+          output -> cd();
+          output -> Close();
+          input  -> Close();
+          delete factory;
+          delete loader;
+
+          const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+          return {1., elapsed.count(), deviation, dev90};
+
+        }  // end 'RunJob(Job&)'
+
+      public:
+
+        // ----------------------------------------------------------------------
+        //! Getters
+        // ----------------------------------------------------------------------
+        inline std::string         GetCache()   const {return m_cache;}
+        inline std::vector<Job>    GetJobs()    const {return m_jobs;}
+        inline std::vector<Result> GetResults() const {return m_results;}
+        inline TrainHelper         GetHelper()  const {return m_helper;}
+
+        // ----------------------------------------------------------------------
+        //! Add a job
+        // ----------------------------------------------------------------------
+        inline void AddJob(const Job& job) {
+
+          // throw error if type is unknown
+          const bool known = Tools::MapNameToType().count(job.type);
+          if (!known) {
+            std::cerr << "PANIC: unknown method type '" << job.type << "'!" << std::endl;
+            assert(known);
+          }
+          m_jobs.push_back(job);
+          return;
+
+        }  // end 'AddJob(Job&)'
+
+        // ----------------------------------------------------------------------
+        //! Add a scan over options of a method
+        // ----------------------------------------------------------------------
+        /*! Adds one job per set of options, named
+         *  "<type>_<index of options>".
+         */
+        inline void AddScan(const std::string& type, const std::vector<std::string>& options) {
+
+          for (std::size_t iOpt = 0; iOpt < options.size(); ++iOpt) {
+            AddJob( {type + "_" + std::to_string(iOpt), type, options[iOpt]} );
+          }
+          return;
+
+        }  // end 'AddScan(std::string&, std::vector<std::string>&)'
+
+        // ----------------------------------------------------------------------
+        //! Skim input tree into local cache
+        // ----------------------------------------------------------------------
+        /*! Keeps only the branches read by the training variables,
+         *  targets, (if needed) spectators, and cuts, and only
+         *  entries passing the cuts. If `reuse` is set and the cache
+         *  already exists and was made from the same input, variables,
+         *  and cuts, it's used as-is. The tree's branch statuses are left
+         *  as they were found.
+         */
+        inline void CacheSamples(TTree* tree, const std::string& path, const bool reuse = false) {
+
+          m_cache      = path;
+          m_cache_tree = tree -> GetName();
+
+          const std::string signature = GetCacheSignature(tree);
+          if (reuse && IsCacheValid(path, signature)) {
+            std::cout << "    Reusing sample cache '" << path << "'." << std::endl;
+            return;
+          } else if (reuse && Tools::DoesFileExist(path)) {
+            std::cerr << "WARNING: sample cache '" << path << "' was made from a different input or with different variables or cuts, remaking it." << std::endl;
+          }
+
+          // find branches needed before touching any statuses
+          std::set<std::string> needed;
+          for (const std::string& expr : GetExpressions()) {
+            const std::set<std::string> used = GetBranchesUsed(tree, expr);
+            needed.insert(used.begin(), used.end());
+          }
+
+          // remember what the caller had switched on/off
+          std::map<std::string, bool> statuses;
+          for (TObject* object : *(tree -> GetListOfLeaves())) {
+            const std::string branch = static_cast<TLeaf*>(object) -> GetBranch() -> GetName();
+            statuses[branch] = tree -> GetBranchStatus( branch.data() );
+          }
+
+          // switch off everything not needed for training
+          tree -> SetBranchStatus("*", false);
+          for (const std::string& branch : needed) {
+            tree -> SetBranchStatus(branch.data(), true);
+          }
+
+          // copy what's left into the cache, and sign it
+          TFile* cache = TFile::Open( path.data(), "recreate" );
+          if (!cache || cache -> IsZombie()) {
+            std::cerr << "WARNING: couldn't create sample cache '" << path << "'! Samples not cached." << std::endl;
+            for (const auto& status : statuses) {
+              tree -> SetBranchStatus(status.first.data(), status.second);
+            }
+            m_cache.clear();
+            return;
+          }
+          cache -> cd();
+          TTree* skim = tree -> CopyTree( m_cuts.GetTitle() );
+          skim  -> Write();
+          TNamed("signature", signature.data()).Write();
+          cache -> Close();
+
+          // restore statuses & exit
+          for (const auto& status : statuses) {
+            tree -> SetBranchStatus(status.first.data(), status.second);
+          }
+          std::cout << "    Cached training samples in '" << path << "'." << std::endl;
+          return;
+
+        }  // end 'CacheSamples(TTree*, std::string&, bool)'
+
+        // ----------------------------------------------------------------------
+        //! Train all jobs
+        // ----------------------------------------------------------------------
+        /*! Runs up to `nworkers` jobs at a time, each in a separate
+         *  process, then writes the summary.
+         */
+        inline void Run(const unsigned int nworkers) {
+
+          // throw error if samples weren't cached
+          if (m_cache.empty()) {
+            std::cerr << "PANIC: samples must be cached before training!" << std::endl;
+            assert(!m_cache.empty());
+          }
+
+          // run jobs in parallel
+          ROOT::TProcessExecutor pool(nworkers);
+          const auto outcomes = pool.Map(
+            [this](const unsigned int iJob) {return RunJob(m_jobs[iJob]);},
+            ROOT::TSeqU(m_jobs.size())
+          );
+
+          // collect results
+          m_results.clear();
+          for (const auto& outcome : outcomes) {
+            Result result;
+            if (outcome.size() == 4) {
+              result.trained   = (outcome[0] > 0.);
+              result.seconds   = outcome[1];
+              result.deviation = outcome[2];
+              result.dev90     = outcome[3];
+            }
+            m_results.push_back(result);
+          }
+          WriteSummary();
+          return;
+
+        }  // end 'Run(unsigned int)'
+
+        // ----------------------------------------------------------------------
+        //! Write summary of jobs
+        // ----------------------------------------------------------------------
+        inline void WriteSummary() const {
+
+          const std::string path = m_directory + "/" + m_name + "_summary.txt";
+          std::ofstream summary(path);
+          summary << std::left
+                  << std::setw(24) << "# job"
+                  << std::setw(12) << "type"
+                  << std::setw(10) << "trained"
+                  << std::setw(14) << "seconds"
+                  << std::setw(14) << "deviation"
+                  << std::setw(14) << "dev90"
+                  << "weights"
+                  << "\n";
+
+          for (std::size_t iJob = 0; iJob < m_jobs.size(); ++iJob) {
+            const Result result = (iJob < m_results.size()) ? m_results[iJob] : Result();
+            summary << std::setw(24) << m_jobs[iJob].name
+                    << std::setw(12) << m_jobs[iJob].type
+                    << std::setw(10) << result.trained
+                    << std::setw(14) << result.seconds
+                    << std::setw(14) << result.deviation
+                    << std::setw(14) << result.dev90
+                    << m_directory + "/weights/" + m_name + "_" + m_jobs[iJob].name + ".weights.xml"
+                    << "\n";
+          }
+          std::cout << "    Wrote training summary to '" << path << "'." << std::endl;
+          return;
+
+        }  // end 'WriteSummary()'
+
+        // ----------------------------------------------------------------------
+        //! Default ctor/dtor
+        // ----------------------------------------------------------------------
+        TrainScheduler()  {};
+        ~TrainScheduler() {};
+
+        // ----------------------------------------------------------------------
+        //! ctor accepting parameters, an output directory, and a name
+        // ----------------------------------------------------------------------
+        /*! Every method in the parameters is added as a job;
+         *  more can be added via `AddJob` or `AddScan`.
+         */
+        TrainScheduler(
+          const Parameters& params,
+          const std::string& directory,
+          const std::string& name
+        ) : m_helper(params.variables, {}) {
+
+          m_add_watchers = params.add_spectators;
+          m_weight       = params.tree_weight;
+          m_cuts         = params.training_cuts;
+          m_directory    = directory;
+          m_name         = name;
+          m_helper.SetFactoryOptions( params.opts_factory );
+          m_helper.SetTrainOptions( params.opts_training );
+
+          for (const auto& method : params.methods) {
+            AddJob( {method.first, method.first, method.second} );
+          }
+
+        }  // end ctor(Parameters&, std::string&, std::string&)'
+
+    };  // end TrainScheduler
+
+  }  // end MVA namespace
+}  // end ROOTAnalysisUtilities namespace
+
+#endif
+
+// end ========================================================================
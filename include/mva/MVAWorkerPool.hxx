@@ -0,0 +1,178 @@
+/// ===========================================================================
+/*! \file   MVAWorkerPool.hxx
+ *  \author Derek Anderson
+ *  \date   10.16.2026
+ *
+ *  Persistent threads to evaluate blocks of events with.
+ */
+/// ===========================================================================
+
+#ifndef RAU_MVAWORKERPOOL_HXX
+#define RAU_MVAWORKERPOOL_HXX
+
+// c++ utilities
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+
+namespace ROOTAnalysisUtilities {
+  namespace MVA {
+
+    // ==========================================================================
+    //! Worker pool
+    // ==========================================================================
+    /*! A small class to keep a set of threads around between
+     *  calls, so that running a task on every block of events
+     *  doesn't pay for making (and joining) threads each time.
+     *  The calling thread always acts as worker 0.
+     */
+    class WorkerPool {
+
+      private:
+
+        // data members
+        bool                             m_stop       = false;
+        std::size_t                      m_generation = 0;
+        std::size_t                      m_ntasks     = 0;
+        std::size_t                      m_busy       = 0;
+        std::function<void(std::size_t)> m_task;
+        std::vector<std::thread>         m_threads;
+
+        // synchronization
+        std::mutex              m_mutex;
+        std::condition_variable m_start;
+        std::condition_variable m_done;
+
+        // ----------------------------------------------------------------------
+        //! Loop run by each thread
+        // ----------------------------------------------------------------------
+        /*! Thread starts out having seen every task
+         *  given before it was made.
+         */
+        void Work(const std::size_t iWorker, std::size_t seen) {
+
+          while (true) {
+
+            // wait for a new task (or to be stopped)
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_start.wait(lock, [&]() {return m_stop || (m_generation != seen);});
+            if (m_stop) return;
+            seen = m_generation;
+
+            // task can't change until every worker is done
+            const bool has_task = (iWorker < m_ntasks);
+            lock.unlock();
+            if (has_task) m_task(iWorker);
+
+            lock.lock();
+            if (--m_busy == 0) m_done.notify_one();
+          }
+
+        }  // end 'Work(std::size_t, std::size_t)'
+
+        // ----------------------------------------------------------------------
+        //! Stop and join all threads
+        // ----------------------------------------------------------------------
+        void Stop() {
+
+          {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+          }
+          m_start.notify_all();
+          for (auto& thread : m_threads) {
+            thread.join();
+          }
+          m_threads.clear();
+          m_stop = false;
+          return;
+
+        }  // end 'Stop()'
+
+      public:
+
+        // ----------------------------------------------------------------------
+        //! Get no. of workers (including the calling thread)
+        // ----------------------------------------------------------------------
+        std::size_t GetNWorkers() const {return m_threads.size() + 1;}
+
+        // ----------------------------------------------------------------------
+        //! Run a task on some no. of workers
+        // ----------------------------------------------------------------------
+        /*! Calls task(iWorker) for each iWorker in [0, ntasks)
+         *  and returns once all of them are done.
+         */
+        void Run(const std::size_t ntasks, const std::function<void(std::size_t)>& task) {
+
+          // throw error if too many tasks
+          if (ntasks > GetNWorkers()) {
+            std::cerr << "PANIC: trying to run " << ntasks << " tasks on " << GetNWorkers() << " workers!" << std::endl;
+            assert(ntasks <= GetNWorkers());
+          }
+
+          if (ntasks <= 1) {
+            if (ntasks == 1) task(0);
+            return;
+          }
+
+          {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_task   = task;
+            m_ntasks = ntasks;
+            m_busy   = m_threads.size();
+            ++m_generation;
+          }
+          m_start.notify_all();
+          task(0);
+
+          std::unique_lock<std::mutex> lock(m_mutex);
+          m_done.wait(lock, [&]() {return m_busy == 0;});
+          return;
+
+        }  // end 'Run(std::size_t, std::function<void(std::size_t)>&)'
+
+        // ----------------------------------------------------------------------
+        //! Set no. of workers
+        // ----------------------------------------------------------------------
+        void SetNWorkers(const std::size_t nworkers) {
+
+          Stop();
+          for (std::size_t iWorker = 1; iWorker < nworkers; ++iWorker) {
+            m_threads.emplace_back(&WorkerPool::Work, this, iWorker, m_generation);
+          }
+          return;
+
+        }  // end 'SetNWorkers(std::size_t)'
+
+        // ----------------------------------------------------------------------
+        //! default ctor/dtor
+        // ----------------------------------------------------------------------
+        WorkerPool()  {};
+        ~WorkerPool() {Stop();};
+
+        // ----------------------------------------------------------------------
+        //! ctor accepting no. of workers
+        // ----------------------------------------------------------------------
+        WorkerPool(const std::size_t nworkers) {
+          SetNWorkers(nworkers);
+        }
+
+        // no copying
+        WorkerPool(const WorkerPool&)            = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+    };  // end WorkerPool
+
+  }  // end MVA namespace
+}  // end ROOTAnalysisUtilities namespace
+
+#endif
+
+// end ========================================================================
@@ -12,6 +12,7 @@
 
 // components
 #include "NTupleHelper.hxx"
+#include "NTupleReader.hxx"
 
 #endif
 
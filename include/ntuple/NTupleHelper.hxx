@@ -27,6 +27,11 @@ namespace ROOTAnalysisUtilities {
   }
 }
 
+// forward declaration of NTupleReader
+namespace ROOTAnalysisUtilities {
+  class NTupleReader;
+}
+
 
 
 namespace ROOTAnalysisUtilities {
@@ -51,8 +56,33 @@ namespace ROOTAnalysisUtilities {
       // ------------------------------------------------------------------------
       //! Getters
       // ------------------------------------------------------------------------
-      inline std::vector<float>       GetValues()    const {return m_values;}
-      inline std::vector<std::string> GetVariables() const {return m_variables;}
+      inline const std::vector<float>& GetValues()    const {return m_values;}
+      inline std::vector<std::string>  GetVariables() const {return m_variables;}
+
+      // ------------------------------------------------------------------------
+      //! Get position of a variable
+      // ------------------------------------------------------------------------
+      /*! The position can be used in place of the variable name
+       *  to skip the name lookup when getting/setting values
+       *  in a loop.
+       */
+      inline std::size_t GetIndex(const std::string& var) const {
+
+        // check if variable exists
+        if (!m_index.count(var)) {
+          assert(m_index.count(var));
+        }
+
+        // then get position
+        return m_index.at(var);
+
+      }  // end 'GetIndex(std::string&)'
+
+      // ------------------------------------------------------------------------
+      //! Get/set a specific variable by position
+      // ------------------------------------------------------------------------
+      inline float GetVariable(const std::size_t index) const {return m_values[index];}
+      inline void  SetVariable(const std::size_t index, const float val) {m_values[index] = val;}
 
       // ------------------------------------------------------------------------
       //! Get a specific variable
@@ -171,8 +201,9 @@ namespace ROOTAnalysisUtilities {
 
       }  // end ctor(TNtuple*)
 
-      // make MVA::ReadHelper a friend
+      // make MVA::ReadHelper and NTupleReader friends
       friend class MVA::ReadHelper;
+      friend class NTupleReader;
 
   };    // end NTupleHelper
 
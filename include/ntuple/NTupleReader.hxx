@@ -0,0 +1,515 @@
+/// ===========================================================================
+/*! \file   NTupleReader.hxx
+ *  \author Derek Anderson
+ *  \date   10.16.2026
+ *
+ *  Columnar, block-by-block reader for TNtuple's.
+ */
+/// ===========================================================================
+
+#ifndef NTupleReader_hxx
+#define NTupleReader_hxx
+
+// c++ utilities
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <future>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+// root libraries
+#include <TBranch.h>
+#include <TBufferFile.h>
+#include <TLeaf.h>
+#include <TMath.h>
+#include <TROOT.h>
+#include <TTree.h>
+// rau components
+#include "../instrument/InstrumentMacros.hxx"
+#include "NTupleHelper.hxx"
+
+
+
+namespace ROOTAnalysisUtilities {
+
+  // ============================================================================
+  //! NTuple Reader
+  // ============================================================================
+  /*! A small class to read a TNtuple (or any TTree of floats)
+   *  N entries at a time. Each block of entries is stored
+   *  column by column, and columns are accessed through a
+   *  handle resolved once via `GetColumn`, e.g.
+   *
+   *    NTupleReader reader(tuple, {"x", "y"});
+   *    const std::size_t x = reader.GetColumn("x");
+   *    while (reader.Next()) {
+   *      const float* vals = reader.GetData(x);
+   *      for (std::size_t i = 0; i < reader.GetSize(); ++i) {
+   *        ...
+   *      }
+   *    }
+   *
+   *  Only the requested branches are read, and they're added
+   *  to the tree's cache. Where ROOT supports it (e.g. the
+   *  float leaves of a TNtuple), a whole basket of a branch
+   *  is read in one go with TBranch's bulk API and copied
+   *  straight into its column; otherwise each branch is read
+   *  entry by entry. Optionally, the next block can be read
+   *  in the background while the current one is processed.
+   *
+   *  Note that the reader takes over the branch addresses and
+   *  statuses of the tree while it exists. Statuses are put
+   *  back as they were found (and addresses reset) once the
+   *  reader is destroyed.
+   */
+  class NTupleReader {
+
+    private:
+
+      // ========================================================================
+      //! Block of entries
+      // ========================================================================
+      struct Block {
+        Long64_t                        first = 0;
+        std::size_t                     size  = 0;
+        std::vector<std::vector<float>> columns;
+      };
+
+      // ========================================================================
+      //! Branch being read into a column
+      // ========================================================================
+      /*! Holds the last basket read in bulk, which covers
+       *  entries [first, first + count) of the current tree.
+       */
+      struct Source {
+        TBranch*                     branch = nullptr;
+        bool                         bulk   = false;
+        Long64_t                     first  = -1;
+        Long64_t                     count  = 0;
+        std::unique_ptr<TBufferFile> basket;
+      };
+
+      // data members
+      TTree*                             m_tree       = nullptr;
+      bool                               m_read_ahead = false;
+      Long64_t                           m_next       = 0;
+      Long64_t                           m_stop       = 0;
+      std::size_t                        m_block_size = 4096;
+      std::atomic<Long64_t>              m_bytes{0};
+      std::vector<float>                 m_values;
+      std::vector<std::string>           m_columns;
+      std::map<std::string, std::size_t> m_index;
+      std::vector<Source>                m_sources;
+      Int_t                              m_tree_number = -1;
+
+      // branch statuses of the tree before it was read
+      std::map<std::string, bool> m_statuses;
+
+      // positions of columns in the last helper used, which
+      // only depend on the helper's list of variables
+      mutable std::vector<std::string>                         m_helper_vars;
+      mutable std::vector<std::pair<std::size_t, std::size_t>> m_helper_slots;
+
+      // blocks being processed and read ahead
+      Block             m_current;
+      Block             m_ahead;
+      std::future<void> m_pending;
+
+      // ------------------------------------------------------------------------
+      //! Get no. of entries in a block starting at a given entry
+      // ------------------------------------------------------------------------
+      inline std::size_t GetBlockSize(const Long64_t first) const {
+
+        if (first >= m_stop) return 0;
+        return std::min<Long64_t>(m_block_size, m_stop - first);
+
+      }  // end 'GetBlockSize(Long64_t)'
+
+      // ------------------------------------------------------------------------
+      //! Look up branches of the current tree
+      // ------------------------------------------------------------------------
+      /*! Needed whenever a TChain moves on to a new tree. Bulk
+       *  reads are only used for branches holding a single float
+       *  per entry.
+       */
+      inline void ResolveSources() {
+
+        m_sources.resize(m_columns.size());
+        for (std::size_t icol = 0; icol < m_columns.size(); ++icol) {
+
+          Source& source = m_sources[icol];
+          source.branch  = m_tree -> GetTree() -> GetBranch( m_columns[icol].data() );
+          source.first   = -1;
+          source.count   = 0;
+
+          const TLeaf* leaf = source.branch ? source.branch -> GetLeaf( m_columns[icol].data() ) : nullptr;
+          source.bulk = leaf
+                     && source.branch -> SupportsBulkRead()
+                     && (std::string(leaf -> GetTypeName()) == "Float_t");
+          if (source.bulk && !source.basket) {
+            source.basket = std::make_unique<TBufferFile>(TBuffer::kWrite, 32 * 1024);
+          }
+        }
+        m_tree_number = m_tree -> GetTreeNumber();
+        return;
+
+      }  // end 'ResolveSources()'
+
+      // ------------------------------------------------------------------------
+      //! Read a range of entries of the current tree into a column
+      // ------------------------------------------------------------------------
+      /*! Returns the no. of bytes read. If a bulk read fails,
+       *  the branch falls back to being read entry by entry.
+       */
+      inline Long64_t ReadColumn(
+        const std::size_t icol,
+        const Long64_t first,
+        const std::size_t size,
+        float* column
+      ) {
+
+        Source&  source = m_sources[icol];
+        Long64_t bytes  = 0;
+        Long64_t entry  = first;
+        while (entry < first + static_cast<Long64_t>(size)) {
+
+          if (!source.bulk) {
+            bytes += source.branch -> GetEntry(entry);
+            column[entry - first] = m_values[icol];
+            ++entry;
+            continue;
+          }
+
+          // bulk reads always start from the beginning of a basket
+          if ((entry < source.first) || (entry >= source.first + source.count)) {
+            const Long64_t* starts  = source.branch -> GetBasketEntry();
+            const Long64_t  ibasket = TMath::BinarySearch(source.branch -> GetWriteBasket() + 1, starts, entry);
+
+            source.first = starts[ibasket];
+            source.count = source.branch -> GetBulkRead().GetBulkEntries(source.first, *source.basket);
+            if (source.count <= entry - source.first) {
+              source.bulk  = false;
+              source.first = -1;
+              source.count = 0;
+              continue;
+            }
+            bytes += source.count * sizeof(float);
+          }
+
+          // copy as much of the basket as is needed
+          const float*   values = reinterpret_cast<const float*>( source.basket -> GetCurrent() );
+          const Long64_t ncopy  = std::min(source.first + source.count, first + static_cast<Long64_t>(size)) - entry;
+          std::copy(
+            values + (entry - source.first),
+            values + (entry - source.first) + ncopy,
+            column + (entry - first)
+          );
+          entry += ncopy;
+        }
+        return bytes;
+
+      }  // end 'ReadColumn(std::size_t, Long64_t, std::size_t, float*)'
+
+      // ------------------------------------------------------------------------
+      //! Read a block of entries
+      // ------------------------------------------------------------------------
+      inline void ReadBlock(Block& block, const Long64_t first) {
+
+        RAU_TIME_SCOPE("ntuple.read_block");
+        block.first = first;
+        block.size  = GetBlockSize(first);
+        block.columns.resize(m_columns.size());
+        for (auto& column : block.columns) {
+          column.resize(block.size);
+        }
+
+        // read column by column, one tree (of a chain) at a time
+        Long64_t    bytes  = 0;
+        std::size_t filled = 0;
+        while (filled < block.size) {
+
+          const Long64_t local = m_tree -> LoadTree(first + filled);
+          if (local < 0) {
+            std::cerr << "PANIC: couldn't load entry " << first + filled << "!" << std::endl;
+            assert(local >= 0);
+          }
+          if (m_tree -> GetTreeNumber() != m_tree_number) {
+            ResolveSources();
+          }
+
+          const std::size_t size = std::min<Long64_t>(
+            block.size - filled,
+            m_tree -> GetTree() -> GetEntries() - local
+          );
+          for (std::size_t icol = 0; icol < m_columns.size(); ++icol) {
+            bytes += ReadColumn(icol, local, size, block.columns[icol].data() + filled);
+          }
+          filled += size;
+        }
+        m_bytes += bytes;
+        RAU_COUNT("ntuple.bytes_read", bytes);
+        RAU_COUNT("ntuple.entries_read", block.size);
+        return;
+
+      }  // end 'ReadBlock(Block&, Long64_t)'
+
+      // ------------------------------------------------------------------------
+      //! Start reading the next block in the background
+      // ------------------------------------------------------------------------
+      inline void ReadAhead() {
+
+        const Long64_t first = m_next;
+        m_next += GetBlockSize(first);
+        m_pending = std::async(
+          std::launch::async,
+          [this, first]() {ReadBlock(m_ahead, first);}
+        );
+        return;
+
+      }  // end 'ReadAhead()'
+
+      // ------------------------------------------------------------------------
+      //! Wait for any background read to finish
+      // ------------------------------------------------------------------------
+      inline void WaitForPending() {
+
+        if (m_pending.valid()) {
+          m_pending.get();
+        }
+        return;
+
+      }  // end 'WaitForPending()'
+
+      // ------------------------------------------------------------------------
+      //! Bind columns to branches
+      // ------------------------------------------------------------------------
+      inline void BindColumns(const std::size_t cache_size) {
+
+        // remember what the caller had switched on/off (a
+        // chain only lists leaves once a tree is loaded)
+        if (!m_tree -> GetTree()) {
+          m_tree -> LoadTree(0);
+        }
+        if (m_tree -> GetListOfLeaves()) {
+          for (TObject* object : *(m_tree -> GetListOfLeaves())) {
+            const std::string branch = static_cast<TLeaf*>(object) -> GetBranch() -> GetName();
+            m_statuses[branch] = m_tree -> GetBranchStatus( branch.data() );
+          }
+        }
+
+        // switch off everything that's not needed
+        m_tree -> SetBranchStatus("*", false);
+
+        m_values.resize(m_columns.size());
+        for (std::size_t icol = 0; icol < m_columns.size(); ++icol) {
+
+          // throw error if branch doesn't exist
+          const bool has_branch = m_tree -> GetBranch( m_columns[icol].data() );
+          if (!has_branch) {
+            std::cerr << "PANIC: trying to read column '" << m_columns[icol] << "' which is not in input tree!" << std::endl;
+            assert(has_branch);
+          }
+
+          m_index[ m_columns[icol] ] = icol;
+          m_tree -> SetBranchStatus( m_columns[icol].data(), true );
+          m_tree -> SetBranchAddress( m_columns[icol].data(), &m_values[icol] );
+        }
+
+        // and only cache what will be read
+        m_tree -> SetCacheSize(cache_size);
+        for (const std::string& column : m_columns) {
+          m_tree -> AddBranchToCache( column.data(), true );
+        }
+        m_tree -> StopCacheLearningPhase();
+        return;
+
+      }  // end 'BindColumns(std::size_t)'
+
+    public:
+
+      // ------------------------------------------------------------------------
+      //! Getters
+      // ------------------------------------------------------------------------
+      inline std::size_t              GetSize()       const {return m_current.size;}
+      inline std::size_t              GetBlockSize()  const {return m_block_size;}
+      inline Long64_t                 GetFirstEntry() const {return m_current.first;}
+      inline Long64_t                 GetBytesRead()  const {return m_bytes;}
+      inline std::vector<std::string> GetColumns()    const {return m_columns;}
+
+      // ------------------------------------------------------------------------
+      //! Get handle for a column
+      // ------------------------------------------------------------------------
+      inline std::size_t GetColumn(const std::string& name) const {
+
+        // check if column exists
+        if (!m_index.count(name)) {
+          assert(m_index.count(name));
+        }
+
+        // then get handle
+        return m_index.at(name);
+
+      }  // end 'GetColumn(std::string&)'
+
+      // ------------------------------------------------------------------------
+      //! Get values of a column in current block
+      // ------------------------------------------------------------------------
+      inline const std::vector<float>& GetValues(const std::size_t column) const {return m_current.columns[column];}
+      inline const float*              GetData(const std::size_t column)   const {return m_current.columns[column].data();}
+
+      // ------------------------------------------------------------------------
+      //! Copy an entry of the current block into an NTupleHelper
+      // ------------------------------------------------------------------------
+      /*! Any column not in the helper is skipped. Where each
+       *  column goes is only looked up when a helper with a
+       *  different list of variables is passed.
+       */
+      inline void GetEntry(const std::size_t entry, NTupleHelper& helper) const {
+
+        if (helper.m_variables != m_helper_vars) {
+          BindHelper(helper);
+        }
+        for (const auto& slot : m_helper_slots) {
+          helper.m_values[slot.second] = m_current.columns[slot.first][entry];
+        }
+        return;
+
+      }  // end 'GetEntry(std::size_t, NTupleHelper&)'
+
+      // ------------------------------------------------------------------------
+      //! Look up where each column goes in an NTupleHelper
+      // ------------------------------------------------------------------------
+      inline void BindHelper(const NTupleHelper& helper) const {
+
+        m_helper_vars = helper.m_variables;
+        m_helper_slots.clear();
+        for (std::size_t icol = 0; icol < m_columns.size(); ++icol) {
+          const auto found = helper.m_index.find( m_columns[icol] );
+          if (found == helper.m_index.end()) continue;
+          m_helper_slots.emplace_back(icol, found -> second);
+        }
+        return;
+
+      }  // end 'BindHelper(NTupleHelper&)'
+
+      // ------------------------------------------------------------------------
+      //! Turn on/off reading the next block in the background
+      // ------------------------------------------------------------------------
+      inline void SetReadAhead(const bool read_ahead) {
+
+        WaitForPending();
+        if (read_ahead) {
+          ROOT::EnableThreadSafety();
+        }
+
+        // make sure background read picks up from the current block
+        if (m_read_ahead && !read_ahead) {
+          m_next = m_current.first + m_current.size;
+        }
+        m_read_ahead = read_ahead;
+        return;
+
+      }  // end 'SetReadAhead(bool)'
+
+      // ------------------------------------------------------------------------
+      //! Set range of entries to read
+      // ------------------------------------------------------------------------
+      /*! Reading restarts from `first`. If `stop` is negative,
+       *  reads until the end of the tree.
+       */
+      inline void SetRange(const Long64_t first, const Long64_t stop = -1) {
+
+        WaitForPending();
+        m_next         = first;
+        m_stop         = (stop < 0) ? m_tree -> GetEntries() : std::min(stop, m_tree -> GetEntries());
+        m_current.size = 0;
+        return;
+
+      }  // end 'SetRange(Long64_t, Long64_t)'
+
+      // ------------------------------------------------------------------------
+      //! Read the next block of entries
+      // ------------------------------------------------------------------------
+      /*! Returns false once there are no entries left. */
+      inline bool Next() {
+
+        if (!m_read_ahead) {
+          ReadBlock(m_current, m_next);
+          m_next += m_current.size;
+          return (m_current.size > 0);
+        }
+
+        // collect block read in the background, and
+        // start on the one after that
+        if (!m_pending.valid()) {
+          ReadAhead();
+        }
+        WaitForPending();
+        std::swap(m_current, m_ahead);
+        if (m_current.size == 0) {
+          return false;
+        }
+        ReadAhead();
+        return true;
+
+      }  // end 'Next()'
+
+      // ------------------------------------------------------------------------
+      //! default ctor/dtor
+      // ------------------------------------------------------------------------
+      NTupleReader() {};
+
+      ~NTupleReader() {
+        WaitForPending();
+        if (m_tree) {
+          m_tree -> ResetBranchAddresses();
+          for (const auto& status : m_statuses) {
+            m_tree -> SetBranchStatus(status.first.data(), status.second);
+          }
+        }
+      };
+
+      // ------------------------------------------------------------------------
+      //! ctor accepting a tree and list of columns to read
+      // ------------------------------------------------------------------------
+      NTupleReader(
+        TTree* tree,
+        const std::vector<std::string>& columns,
+        const std::size_t block_size = 4096,
+        const std::size_t cache_size = 30000000
+      ) {
+
+        m_tree       = tree;
+        m_columns    = columns;
+        m_block_size = std::max<std::size_t>(block_size, 1);
+        m_stop       = m_tree -> GetEntries();
+        BindColumns(cache_size);
+
+      }  // end ctor(TTree*, std::vector<std::string>&, std::size_t x 2)
+
+      // ------------------------------------------------------------------------
+      //! ctor accepting a tree and an NTupleHelper
+      // ------------------------------------------------------------------------
+      /*! Reads all of the helper's variables. */
+      NTupleReader(
+        TTree* tree,
+        const NTupleHelper& helper,
+        const std::size_t block_size = 4096,
+        const std::size_t cache_size = 30000000
+      ) : NTupleReader(tree, helper.GetVariables(), block_size, cache_size) {
+
+        BindHelper(helper);
+
+      }  // end ctor(TTree*, NTupleHelper&, std::size_t x 2)
+
+  };  // end NTupleReader
+
+}  // end ROOTAnalysisUtilities namespace
+
+#endif
+
+// end ========================================================================
@@ -40,7 +40,7 @@ namespace ROOTAnalysisUtilities {
 
         // members
         PadOpts           m_opts;
-        Types::Margins    m_mgns;
+        Types::Margins    m_mgns = {0.1, 0.1, 0.1, 0.1};
         Types::Dimensions m_dims;
         std::string       m_name;
         std::string       m_title = "";
@@ -35,8 +35,8 @@ namespace ROOTAnalysisUtilities {
 
         // members
         PadOpts         m_opts;
-        Types::Vertices m_vtxs;
-        Types::Margins  m_mgns;
+        Types::Vertices m_vtxs = {0., 0., 1., 1.};
+        Types::Margins  m_mgns = {0.1, 0.1, 0.1, 0.1};
         std::string     m_name;
         std::string     m_title = "";
 
@@ -34,7 +34,7 @@ namespace ROOTAnalysisUtilities {
 
         // data members
         Types::TextList m_text;
-        Types::Vertices m_vtxs;
+        Types::Vertices m_vtxs = {0., 0., 1., 1.};
         std::string     m_opt = "NDC NB";
 
       public:
@@ -13,7 +13,10 @@
 
 // components
 #include "PlotterBase.hxx"
+#include "PlotterBatch.hxx"
+#include "PlotterFileCache.hxx"
 #include "PlotterInput.hxx"
+#include "PlotterJob.hxx"
 #include "PlotterTools.hxx"
 
 #endif
@@ -25,7 +25,9 @@
 #include <TObject.h>
 #include <TPaveText.h>
 // rau components
+#include "../instrument/InstrumentMacros.hxx"
 #include "../plot/Plot.hxx"
+#include "PlotterFileCache.hxx"
 #include "PlotterInput.hxx"
 #include "PlotterTools.hxx"
 
@@ -52,6 +54,7 @@ namespace ROOTAnalysisUtilities {
         Plot::Style   m_basePlotStyle;
         Plot::Style   m_baseTextStyle;
         Plot::TextBox m_textBox;
+        FileCache*    m_cache = nullptr;
 
         // --------------------------------------------------------------------
         //! Generate list of styles to be applied
@@ -74,6 +77,7 @@ namespace ROOTAnalysisUtilities {
         Plot::Style   GetBasePlotStyle() const {return m_basePlotStyle;}
         Plot::Style   GetBaseTextStyle() const {return m_baseTextStyle;}
         Plot::TextBox GetTextBox()       const {return m_textBox;}
+        FileCache*    GetFileCache()     const {return m_cache;}
 
         // --------------------------------------------------------------------
         //! Setters
@@ -82,6 +86,16 @@ namespace ROOTAnalysisUtilities {
         void SetBaseTextStyle(const Plot::Style& style) {m_baseTextStyle = style;}
         void SetTextBox(const Plot::TextBox& text)      {m_textBox       = text;}
 
+        // --------------------------------------------------------------------
+        //! Set a cache of input files
+        // --------------------------------------------------------------------
+        /*! If set, inputs are read through the cache (so files
+         *  stay open across routines) rather than opened and
+         *  closed by each routine. The cache isn't owned by the
+         *  plotter.
+         */
+        void SetFileCache(FileCache* cache) {m_cache = cache;}
+
         /* TODO add
          *   - Compare spectra against a baseline
          *   - Compare ratios of pairs of spectra
@@ -107,6 +121,8 @@ namespace ROOTAnalysisUtilities {
           std::optional<std::string> header
         ) {
 
+          RAU_TIME_SCOPE("plotter.plot_spectra");
+
           // announce start
           std::cout << "\n -------------------------------- \n"
                     << "  Beginning energy spectra plotting!\n"
@@ -118,13 +134,19 @@ namespace ROOTAnalysisUtilities {
           std::vector<TH1*>   ihists;
           for (const Input& input : inputs) {
 
-            ifiles.push_back(
-              Tools::OpenFile(input.file, "read")
-            );
-            ihists.push_back(
-              (TH1*) Tools::GrabObject( input.object, ifiles.back() )
-            );
-            ihists.back() -> SetName( input.rename.data() );
+            if (m_cache) {
+              ihists.push_back(
+                (TH1*) m_cache -> CloneObject( input.file, input.object, input.rename )
+              );
+            } else {
+              ifiles.push_back(
+                Tools::OpenFile(input.file, "read")
+              );
+              ihists.push_back(
+                (TH1*) Tools::GrabObject( input.object, ifiles.back() )
+              );
+              ihists.back() -> SetName( input.rename.data() );
+            }
             std::cout << "      File = " << input.file << "\n"
                       << "      Hist = " << input.object
                       << std::endl;
@@ -197,11 +219,16 @@ namespace ROOTAnalysisUtilities {
           manager.Close();
           std::cout << "    Saved output." << std::endl;
 
-          // close input files
+          // close input files (or clean up copies from cache)
           for (TFile* ifile : ifiles) {
             ifile -> cd();
             ifile -> Close();
           }
+          if (m_cache) {
+            for (TH1* hist : ihists) {
+              delete hist;
+            }
+          }
           std::cout << "    Closed input files." << std::endl;
 
           // announce end
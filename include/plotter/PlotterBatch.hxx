@@ -0,0 +1,463 @@
+/// ===========================================================================
+/*! \file   PlotterBatch.hxx
+ *  \author Derek Anderson
+ *  \date   10.16.2026
+ *
+ *  Driver for making many plots at once.
+ */
+/// ===========================================================================
+
+#ifndef RAU_PLOTTERBATCH_HXX
+#define RAU_PLOTTERBATCH_HXX
+
+// c++ utilities
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+// root libraries
+#include <ROOT/TProcessExecutor.hxx>
+#include <ROOT/TSeq.hxx>
+#include <TFile.h>
+#include <TKey.h>
+#include <TROOT.h>
+// rau components
+#include "PlotterBase.hxx"
+#include "PlotterFileCache.hxx"
+#include "PlotterJob.hxx"
+#include "PlotterTools.hxx"
+
+
+
+namespace ROOTAnalysisUtilities {
+  namespace Plotter {
+
+    // ========================================================================
+    //! Batch plotter
+    // ========================================================================
+    /*! A small class to run many plotting jobs through a plotter
+     *  at once, e.g.
+     *
+     *    Plotter::Batch batch(plotter, "plots.manifest");
+     *    batch.AddJob( {inputs, range, canvas, "plot.root", "header"} );
+     *    ...
+     *    batch.Run(4);
+     *
+     *  Jobs are grouped by their first input file, and the groups
+     *  are split across worker processes (ROOT graphics aren't
+     *  safe to use from several threads). Within a worker, every
+     *  input file is opened once and each object read once.
+     *
+     *  A hash of each job (its arguments, plus the metadata of the
+     *  keys of its inputs) is kept in a manifest, so jobs whose
+     *  inputs haven't changed and whose output still exists are
+     *  skipped on later runs. The manifest holds one job per line,
+     *  as "<hash><tab><output>".
+     */
+    class Batch {
+
+      private:
+
+        // members
+        bool                            m_force   = false;
+        std::size_t                     m_nrun    = 0;
+        Base*                           m_plotter = nullptr;
+        std::string                     m_manifest;
+        std::vector<Job>                m_jobs;
+        std::set<std::string>           m_outputs;
+        std::map<std::string, uint64_t> m_hashes;
+
+        // for reading key metadata
+        FileCache m_keys;
+
+        // --------------------------------------------------------------------
+        //! Describe parts of a plot for hashing
+        // --------------------------------------------------------------------
+        /*! Everything PlotSpectra uses to draw a plot should
+         *  end up in a description, so that changing any of it
+         *  changes the hash.
+         */
+        void Describe(std::ostream& desc, const Plot::PadOpts& opts) const {
+
+          desc << opts.logx  << " " << opts.logy  << " "
+               << opts.tickx << " " << opts.ticky << " "
+               << opts.gridx << " " << opts.gridy << " "
+               << opts.bmode << " " << opts.bsize << " "
+               << opts.frame << "\n";
+          return;
+
+        }  // end 'Describe(std::ostream&, Plot::PadOpts&)'
+
+        template <typename A> void Describe(std::ostream& desc, const A& array) const {
+
+          for (const float value : array) {
+            desc << value << " ";
+          }
+          desc << "\n";
+          return;
+
+        }  // end 'Describe(std::ostream&, A&)'
+
+        void Describe(std::ostream& desc, const Plot::Canvas& canvas) const {
+
+          desc << canvas.GetName()  << "\n"
+               << canvas.GetTitle() << "\n"
+               << canvas.GetDimensions().first << " "
+               << canvas.GetDimensions().second << "\n";
+          Describe(desc, canvas.GetOptions());
+          Describe(desc, canvas.GetMargins());
+          for (const Plot::Pad& pad : canvas.GetPads()) {
+            desc << pad.GetName()  << "\n"
+                 << pad.GetTitle() << "\n";
+            Describe(desc, pad.GetOptions());
+            Describe(desc, pad.GetVertices());
+            Describe(desc, pad.GetMargins());
+          }
+          return;
+
+        }  // end 'Describe(std::ostream&, Plot::Canvas&)'
+
+        void Describe(std::ostream& desc, const Plot::Style& style) const {
+
+          const Plot::Style::Plot plot = style.GetPlotStyle();
+          const Plot::Style::Text text = style.GetTextStyle();
+          desc << plot.color << " " << plot.marker << " " << plot.fill << " "
+               << plot.line  << " " << plot.width  << "\n"
+               << text.color << " " << text.font   << " " << text.align << " "
+               << text.spacing << "\n";
+          for (const auto& label : style.GetLabelStyles()) {
+            desc << label.color << " " << label.font << " "
+                 << label.size  << " " << label.offset << "\n";
+          }
+          for (const auto& title : style.GetTitleStyles()) {
+            desc << title.color << " " << title.center << " " << title.font << " "
+                 << title.size  << " " << title.offset << "\n";
+          }
+          return;
+
+        }  // end 'Describe(std::ostream&, Plot::Style&)'
+
+        void Describe(std::ostream& desc, const Plot::TextBox& box) const {
+
+          for (const std::string& line : box.GetText()) {
+            desc << line << "\n";
+          }
+          Describe(desc, box.GetVertices());
+          desc << box.GetOption() << "\n";
+          return;
+
+        }  // end 'Describe(std::ostream&, Plot::TextBox&)'
+
+        // --------------------------------------------------------------------
+        //! Describe an input for hashing
+        // --------------------------------------------------------------------
+        /*! Uses the input's key (cycle, date, size, and location
+         *  in the file) rather than the object itself, so nothing
+         *  beyond the key has to be read.
+         */
+        std::string DescribeInput(const Input& input) {
+
+          std::ostringstream desc;
+          desc << input.file   << "\n"
+               << input.object << "\n"
+               << input.rename << "\n"
+               << input.legend << "\n"
+               << input.style.color  << " "
+               << input.style.marker << " "
+               << input.style.fill   << " "
+               << input.style.line   << " "
+               << input.style.width  << "\n";
+
+          TKey* key = Tools::GrabKey( input.object, m_keys.GetFile(input.file) );
+          if (key) {
+            desc << key -> GetCycle()          << " "
+                 << key -> GetDatime().Get()   << " "
+                 << key -> GetNbytes()         << " "
+                 << key -> GetSeekKey()        << "\n";
+          } else {
+            desc << "no key\n";
+          }
+          return desc.str();
+
+        }  // end 'DescribeInput(Input&)'
+
+        // --------------------------------------------------------------------
+        //! Hash a job
+        // --------------------------------------------------------------------
+        uint64_t HashJob(const Job& job) {
+
+          // floats are written exactly
+          std::ostringstream desc;
+          desc << std::hexfloat
+               << job.output << "\n"
+               << job.range.x.first << " " << job.range.x.second << " "
+               << job.range.y.first << " " << job.range.y.second << " "
+               << job.range.z.first << " " << job.range.z.second << "\n"
+               << job.header.value_or("no header") << "\n";
+          Describe(desc, job.canvas);
+
+          // plotter's own styles and text go into every plot
+          Describe(desc, m_plotter -> GetBasePlotStyle());
+          Describe(desc, m_plotter -> GetBaseTextStyle());
+          Describe(desc, m_plotter -> GetTextBox());
+
+          uint64_t hash = Tools::HashString( desc.str() );
+          for (const Input& input : job.inputs) {
+            hash = Tools::HashString( DescribeInput(input), hash );
+          }
+          return hash;
+
+        }  // end 'HashJob(Job&)'
+
+        // --------------------------------------------------------------------
+        //! Read manifest of previous run
+        // --------------------------------------------------------------------
+        void ReadManifest() {
+
+          m_hashes.clear();
+          if (m_manifest.empty()) return;
+
+          // output is everything after the first tab, so
+          // that paths can hold spaces
+          std::ifstream manifest(m_manifest);
+          std::string   line;
+          while (std::getline(manifest, line)) {
+            const std::size_t tab = line.find('\t');
+            if ((tab == 0) || (tab == std::string::npos)) continue;
+
+            std::istringstream hash(line.substr(0, tab));
+            uint64_t           value = 0;
+            if (!(hash >> value)) continue;
+            m_hashes[ line.substr(tab + 1) ] = value;
+          }
+          return;
+
+        }  // end 'ReadManifest()'
+
+        // --------------------------------------------------------------------
+        //! Write manifest of current run
+        // --------------------------------------------------------------------
+        void WriteManifest() const {
+
+          if (m_manifest.empty()) return;
+
+          std::ofstream manifest(m_manifest);
+          for (const auto& entry : m_hashes) {
+            manifest << entry.second << "\t" << entry.first << "\n";
+          }
+          std::cout << "    Wrote manifest to '" << m_manifest << "'." << std::endl;
+          return;
+
+        }  // end 'WriteManifest()'
+
+        // --------------------------------------------------------------------
+        //! Split jobs into chunks for workers
+        // --------------------------------------------------------------------
+        /*! Jobs sharing a first input file stay together, and
+         *  each group goes to whichever chunk is smallest.
+         */
+        std::vector<std::vector<std::size_t>> SplitJobs(
+          const std::vector<std::size_t>& todo,
+          const std::size_t nworkers
+        ) const {
+
+          // group jobs by first input file
+          std::map<std::string, std::vector<std::size_t>> groups;
+          for (const std::size_t ijob : todo) {
+            groups[ m_jobs[ijob].inputs.front().file ].push_back(ijob);
+          }
+
+          // biggest groups first, then fill smallest chunk
+          std::vector<std::vector<std::size_t>> sorted;
+          for (auto& group : groups) {
+            sorted.push_back( std::move(group.second) );
+          }
+          std::stable_sort(
+            sorted.begin(),
+            sorted.end(),
+            [](const auto& lhs, const auto& rhs) {return lhs.size() > rhs.size();}
+          );
+
+          std::vector<std::vector<std::size_t>> chunks( std::min(nworkers, sorted.size()) );
+          for (const auto& group : sorted) {
+            auto smallest = std::min_element(
+              chunks.begin(),
+              chunks.end(),
+              [](const auto& lhs, const auto& rhs) {return lhs.size() < rhs.size();}
+            );
+            smallest -> insert( smallest -> end(), group.begin(), group.end() );
+          }
+          return chunks;
+
+        }  // end 'SplitJobs(std::vector<std::size_t>&, std::size_t)'
+
+        // --------------------------------------------------------------------
+        //! Run a chunk of jobs
+        // --------------------------------------------------------------------
+        /*! Returns the indices of the jobs which finished. Plots
+         *  are drawn in batch mode, and whatever mode ROOT was in
+         *  is restored afterwards.
+         */
+        std::vector<int> RunChunk(const std::vector<std::size_t>& chunk) {
+
+          const bool was_batch = gROOT -> IsBatch();
+          gROOT -> SetBatch(true);
+
+          std::vector<int> finished;
+          FileCache        cache;
+          m_plotter -> SetFileCache(&cache);
+          for (const std::size_t ijob : chunk) {
+            const Job& job    = m_jobs[ijob];
+            TFile*     output = Tools::OpenFile(job.output, "recreate");
+            m_plotter -> PlotSpectra(job.inputs, job.range, job.canvas, output, job.header);
+            output -> cd();
+            output -> Close();
+            delete output;
+            finished.push_back(ijob);
+          }
+          m_plotter -> SetFileCache(nullptr);
+          gROOT -> SetBatch(was_batch);
+          return finished;
+
+        }  // end 'RunChunk(std::vector<std::size_t>&)'
+
+      public:
+
+        // --------------------------------------------------------------------
+        //! Getters
+        // --------------------------------------------------------------------
+        bool             GetForce()    const {return m_force;}
+        std::size_t      GetNRun()     const {return m_nrun;}
+        std::string      GetManifest() const {return m_manifest;}
+        std::vector<Job> GetJobs()     const {return m_jobs;}
+
+        // --------------------------------------------------------------------
+        //! Setters
+        // --------------------------------------------------------------------
+        void SetForce(const bool force)              {m_force    = force;}
+        void SetManifest(const std::string& manifest) {m_manifest = manifest;}
+
+        // --------------------------------------------------------------------
+        //! Add a job
+        // --------------------------------------------------------------------
+        void AddJob(const Job& job) {
+
+          // throw error if nothing to plot
+          if (job.inputs.empty()) {
+            std::cerr << "PANIC: plotting job for '" << job.output << "' has no inputs!" << std::endl;
+            assert(!job.inputs.empty());
+          }
+
+          // throw error if another job writes to the same file
+          const bool is_new = m_outputs.insert(job.output).second;
+          if (!is_new) {
+            std::cerr << "PANIC: more than one plotting job writes to '" << job.output << "'!" << std::endl;
+            assert(is_new);
+          }
+          m_jobs.push_back(job);
+          return;
+
+        }  // end 'AddJob(Job&)'
+
+        // --------------------------------------------------------------------
+        //! Run all jobs
+        // --------------------------------------------------------------------
+        /*! Runs jobs which have changed (or all of them, if forced)
+         *  across up to `nworkers` processes, then updates the
+         *  manifest. Only jobs which finished are recorded as up
+         *  to date, so any which failed (e.g. if a worker crashed)
+         *  are run again next time.
+         */
+        void Run(const unsigned int nworkers = 1) {
+
+          // throw error if no plotter to run
+          if (!m_plotter) {
+            std::cerr << "PANIC: no plotter set for batch!" << std::endl;
+            assert(m_plotter);
+          }
+
+          // determine which jobs need to be run
+          ReadManifest();
+          std::vector<std::size_t> todo;
+          std::vector<uint64_t>    hashes;
+          for (std::size_t ijob = 0; ijob < m_jobs.size(); ++ijob) {
+
+            const Job&     job     = m_jobs[ijob];
+            const uint64_t hash    = HashJob(job);
+            const auto     found   = m_hashes.find(job.output);
+            const bool     same    = (found != m_hashes.end()) && (found -> second == hash);
+            const bool     written = std::ifstream(job.output).good();
+
+            hashes.push_back(hash);
+            if (m_force || !same || !written) {
+              todo.push_back(ijob);
+              m_hashes.erase(job.output);
+            }
+          }
+
+          // make sure no files are left open going into workers
+          m_keys.Clear();
+          m_nrun = todo.size();
+          std::cout << "    Running " << todo.size() << " of " << m_jobs.size() << " plotting jobs." << std::endl;
+
+          // run jobs
+          const auto chunks = SplitJobs(todo, std::max(nworkers, 1u));
+          std::vector<std::vector<int>> finished;
+          if (chunks.size() <= 1) {
+            for (const auto& chunk : chunks) {
+              finished.push_back( RunChunk(chunk) );
+            }
+          } else {
+            ROOT::TProcessExecutor pool(chunks.size());
+            finished = pool.Map(
+              [this, &chunks](const unsigned int ichk) {return RunChunk(chunks[ichk]);},
+              ROOT::TSeqU(chunks.size())
+            );
+          }
+
+          // record finished jobs as up to date
+          std::size_t nfinished = 0;
+          for (const auto& chunk : finished) {
+            for (const int ijob : chunk) {
+              m_hashes[ m_jobs[ijob].output ] = hashes[ijob];
+              ++nfinished;
+            }
+          }
+          if (nfinished < todo.size()) {
+            std::cerr << "WARNING: only " << nfinished << " of " << todo.size() << " plotting jobs finished!" << std::endl;
+          }
+          WriteManifest();
+          return;
+
+        }  // end 'Run(unsigned int)'
+
+        // --------------------------------------------------------------------
+        //! default ctor/dtor
+        // --------------------------------------------------------------------
+        Batch()  {};
+        ~Batch() {};
+
+        // --------------------------------------------------------------------
+        //! ctor accepting a plotter and (optionally) a manifest
+        // --------------------------------------------------------------------
+        Batch(Base& plotter, const std::string& manifest = "") {
+
+          m_plotter  = &plotter;
+          m_manifest = manifest;
+
+        }  // end ctor(Base&, std::string&)'
+
+    };  // end Batch
+
+  }  // end Plotter namespace
+}    // end ROOTAnalysisUtilities namespace
+
+#endif
+
+// end ========================================================================
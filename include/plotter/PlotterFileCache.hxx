@@ -0,0 +1,132 @@
+/// ===========================================================================
+/*! \file   PlotterFileCache.hxx
+ *  \author Derek Anderson
+ *  \date   10.16.2026
+ *
+ *  A cache of open input files and objects read from them.
+ */
+/// ===========================================================================
+
+#ifndef RAU_PLOTTERFILECACHE_HXX
+#define RAU_PLOTTERFILECACHE_HXX
+
+// c++ utilities
+#include <map>
+#include <string>
+#include <utility>
+// root libraries
+#include <TDirectory.h>
+#include <TFile.h>
+#include <TH1.h>
+#include <TObject.h>
+// rau components
+#include "PlotterTools.hxx"
+
+
+
+namespace ROOTAnalysisUtilities {
+  namespace Plotter {
+
+    // ========================================================================
+    //! File cache
+    // ========================================================================
+    /*! A small class to keep input files open, and objects
+     *  already read from them, across many plotting routines
+     *  so that each file is only opened (and each object only
+     *  read) once. Objects handed out are clones, so that
+     *  routines are free to rename/restyle them.
+     */
+    class FileCache {
+
+      private:
+
+        // members
+        std::map<std::string, TFile*>                             m_files;
+        std::map<std::pair<std::string, std::string>, TObject*> m_objects;
+
+      public:
+
+        // --------------------------------------------------------------------
+        //! Getters
+        // --------------------------------------------------------------------
+        std::size_t GetNFiles()   const {return m_files.size();}
+        std::size_t GetNObjects() const {return m_objects.size();}
+
+        // --------------------------------------------------------------------
+        //! Get an open file, opening it if need be
+        // --------------------------------------------------------------------
+        TFile* GetFile(const std::string& name) {
+
+          auto found = m_files.find(name);
+          if (found == m_files.end()) {
+            found = m_files.emplace( name, Tools::OpenFile(name, "read") ).first;
+          }
+          return found -> second;
+
+        }  // end 'GetFile(std::string&)'
+
+        // --------------------------------------------------------------------
+        //! Get an object from a file, reading it if need be
+        // --------------------------------------------------------------------
+        TObject* GetObject(const std::string& file, const std::string& object) {
+
+          const auto key   = std::make_pair(file, object);
+          auto       found = m_objects.find(key);
+          if (found == m_objects.end()) {
+            found = m_objects.emplace( key, Tools::GrabObject(object, GetFile(file)) ).first;
+          }
+          return found -> second;
+
+        }  // end 'GetObject(std::string&, std::string&)'
+
+        // --------------------------------------------------------------------
+        //! Get a copy of an object from a file
+        // --------------------------------------------------------------------
+        /*! The copy is owned by the caller, and histograms are
+         *  kept out of the current directory.
+         */
+        TObject* CloneObject(
+          const std::string& file,
+          const std::string& object,
+          const std::string& rename
+        ) {
+
+          TDirectory::TContext context(nullptr);
+          TObject* clone = GetObject(file, object) -> Clone( rename.data() );
+          if (TH1* hist = dynamic_cast<TH1*>(clone)) {
+            hist -> SetDirectory(nullptr);
+          }
+          return clone;
+
+        }  // end 'CloneObject(std::string&, std::string& x 2)'
+
+        // --------------------------------------------------------------------
+        //! Close all files and forget all objects
+        // --------------------------------------------------------------------
+        void Clear() {
+
+          // objects are owned by their files
+          m_objects.clear();
+          for (auto& file : m_files) {
+            file.second -> Close();
+            delete file.second;
+          }
+          m_files.clear();
+          return;
+
+        }  // end 'Clear()'
+
+        // --------------------------------------------------------------------
+        //! default ctor/dtor
+        // --------------------------------------------------------------------
+        FileCache()  {};
+        ~FileCache() {Clear();};
+
+    };  // end FileCache
+
+  }  // end Plotter namespace
+}    // end ROOTAnalysisUtilities namespace
+
+#endif
+
+// end ========================================================================
@@ -0,0 +1,49 @@
+/// ===========================================================================
+/*! \file   PlotterJob.hxx
+ *  \author Derek Anderson
+ *  \date   10.16.2026
+ *
+ *  Definition of a single plot to be made in a batch.
+ */
+/// ===========================================================================
+
+#ifndef RAU_PLOTTERJOB_HXX
+#define RAU_PLOTTERJOB_HXX
+
+// c++ utilities
+#include <optional>
+#include <string>
+#include <vector>
+// rau components
+#include "../plot/PlotCanvas.hxx"
+#include "../plot/PlotRange.hxx"
+#include "PlotterInput.hxx"
+
+
+
+namespace ROOTAnalysisUtilities {
+  namespace Plotter {
+
+    // ========================================================================
+    //! Plotter job
+    // ========================================================================
+    /*! A small struct to consolidate the arguments of
+     *  a single call to Base::PlotSpectra, along with
+     *  the file its output should go to.
+     */
+    struct Job {
+
+      std::vector<Input>         inputs;  ///!< list of objects to plot
+      Plot::Range                range;   ///!< (x, y) ranges to plot
+      Plot::Canvas               canvas;  ///!< definition of canvas to draw on
+      std::string                output;  ///!< file to write to
+      std::optional<std::string> header;  ///!< optional legend header
+
+    };  // end Job
+
+  }  // end Plotter namespace
+}    // end ROOTAnalysisUtilities namespace
+
+#endif
+
+// end ========================================================================
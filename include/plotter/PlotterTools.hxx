@@ -12,9 +12,12 @@
 
 // c++ utilities
 #include <cassert>
+#include <cstdint>
 #include <string>
 // root libraries
+#include <TDirectory.h>
 #include <TFile.h>
+#include <TKey.h>
 #include <TObject.h>
 
 
@@ -68,6 +71,46 @@ namespace ROOTAnalysisUtilities {
 
     }  // end 'GrabObject(std::string&, TFile*)'
 
+
+
+    // ========================================================================
+    //! Find the key of an object in a file
+    // ========================================================================
+    /*! Handles objects in subdirectories (e.g. "dir/hist").
+     *  Returns null if the object isn't found.
+     */
+    TKey* GrabKey(const std::string& object, TFile* file) {
+
+      // split path into directory and name
+      const std::size_t slash = object.find_last_of('/');
+      if (slash == std::string::npos) {
+        return file -> GetKey( object.data() );
+      }
+
+      TDirectory* dir = file -> GetDirectory( object.substr(0, slash).data() );
+      return dir ? dir -> GetKey( object.substr(slash + 1).data() ) : nullptr;
+
+    }  // end 'GrabKey(std::string&, TFile*)'
+
+
+
+    // ========================================================================
+    //! Hash a string
+    // ========================================================================
+    /*! Uses 64-bit FNV-1a, which is stable across processes
+     *  and runs (unlike std::hash).
+     */
+    uint64_t HashString(const std::string& str, const uint64_t seed = 14695981039346656037ULL) {
+
+      uint64_t hash = seed;
+      for (const char chr : str) {
+        hash ^= static_cast<unsigned char>(chr);
+        hash *= 1099511628211ULL;
+      }
+      return hash;
+
+    }  // end 'HashString(std::string&, uint64_t)'
+
   }  // end Tools namespace
 }    // end ROOTAnalysisUtilities namespace
 
@@ -12,17 +12,1094 @@
 #define TestAnalysisUtilities_cxx
 
 // c++ utilities
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <string>
+#include <thread>
 #include <utility>
+#include <vector>
+// root libraries
+#include <TAxis.h>
+#include <TChain.h>
+#include <TDirectory.h>
+#include <TFile.h>
+#include <TH1.h>
+#include <TH2.h>
+#include <TMemFile.h>
+#include <TNtuple.h>
+#include <TProfile.h>
+#include <TProfile2D.h>
+#include <TRandom3.h>
+#include <TROOT.h>
+#include <TSystem.h>
+// tmva components
+#include <TMVA/DataLoader.h>
+#include <TMVA/Factory.h>
+#include <TMVA/Reader.h>
 // analysis utility
 #include "../include/ROOTAnalysisUtilities.hxx"
 
 
 
-void TestAnalysisUtilities() {
+namespace Test {
 
-  /* TODO tests go here */
+  // --------------------------------------------------------------------------
+  //! Get path to a scratch file
+  // --------------------------------------------------------------------------
+  std::string GetScratchPath(const std::string& name) {
 
-}
+    return std::string( gSystem -> TempDirectory() ) + "/RAUTest_" + name;
+
+  }  // end 'GetScratchPath(std::string&)'
+
+
+  // --------------------------------------------------------------------------
+  //! Check if two numbers agree up to rounding
+  // --------------------------------------------------------------------------
+  bool IsClose(const double a, const double b) {
+
+    if (std::isnan(a) || std::isnan(b)) return std::isnan(a) && std::isnan(b);
+    const double scale = std::max({1., std::abs(a), std::abs(b)});
+    return std::abs(a - b) <= 1e-9 * scale;
+
+  }  // end 'IsClose(double, double)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Make values to probe a binning with
+  // --------------------------------------------------------------------------
+  /*! Includes every edge, the values just either side of
+   *  each edge, bin centers, out-of-range values, infinities,
+   *  and NaN.
+   */
+  std::vector<double> MakeProbes(const std::vector<double>& edges) {
+
+    const double inf = std::numeric_limits<double>::infinity();
+
+    std::vector<double> probes = {
+      -inf,
+      inf,
+      std::numeric_limits<double>::quiet_NaN(),
+      edges.front() - 1.,
+      edges.back() + 1.
+    };
+    for (std::size_t iedge = 0; iedge < edges.size(); ++iedge) {
+      probes.push_back( edges[iedge] );
+      probes.push_back( std::nextafter(edges[iedge], -inf) );
+      probes.push_back( std::nextafter(edges[iedge], inf) );
+      if (iedge + 1 < edges.size()) {
+        probes.push_back( 0.5 * (edges[iedge] + edges[iedge + 1]) );
+      }
+    }
+    return probes;
+
+  }  // end 'MakeProbes(std::vector<double>&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Make random values spanning (and overshooting) a binning
+  // --------------------------------------------------------------------------
+  std::vector<double> MakeValues(
+    const std::vector<double>& edges,
+    const std::size_t nvalues,
+    TRandom3& random
+  ) {
+
+    const double width = edges.back() - edges.front();
+
+    std::vector<double> values = MakeProbes(edges);
+    while (values.size() < nvalues) {
+      values.push_back( random.Uniform(edges.front() - 0.1 * width, edges.back() + 0.1 * width) );
+    }
+    return values;
+
+  }  // end 'MakeValues(std::vector<double>&, std::size_t, TRandom3&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Check that two histograms have the same contents, errors, and stats
+  // --------------------------------------------------------------------------
+  bool SameHists(const TH1* expect, const TH1* actual, const std::string& label) {
+
+    bool same = (expect -> GetNcells() == actual -> GetNcells());
+    same &= (expect -> GetSumw2N() == actual -> GetSumw2N());
+    same &= IsClose(expect -> GetEntries(), actual -> GetEntries());
+    for (int icell = 0; same && (icell < expect -> GetNcells()); ++icell) {
+      same &= IsClose(expect -> GetBinContent(icell), actual -> GetBinContent(icell));
+      same &= IsClose(expect -> GetBinError(icell), actual -> GetBinError(icell));
+    }
+
+    double expect_stats[TH1::kNstat] = {0.};
+    double actual_stats[TH1::kNstat] = {0.};
+    expect -> GetStats(expect_stats);
+    actual -> GetStats(actual_stats);
+    for (int istat = 0; istat < TH1::kNstat; ++istat) {
+      same &= IsClose(expect_stats[istat], actual_stats[istat]);
+    }
+
+    if (!same) {
+      std::cerr << "FAILED: '" << label << "' doesn't match reference histogram" << std::endl;
+    }
+    return same;
+
+  }  // end 'SameHists(TH1*, TH1*, std::string&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Check BinFinder against TAxis::FindBin
+  // --------------------------------------------------------------------------
+  /*! The axis is built from the edges, like those of
+   *  histograms made from a Definition.
+   */
+  bool CheckBinFinder(const RAU::Hist::Binning& binning, const std::string& label) {
+
+    const std::vector<double>& edges = binning.GetBins();
+
+    TAxis                axis(edges.size() - 1, edges.data());
+    RAU::Hist::BinFinder finder(binning);
+
+    bool good = true;
+    for (const double probe : MakeProbes(edges)) {
+      const std::size_t expect = axis.FindBin(probe);
+      const std::size_t actual = finder.Find(probe);
+      if (expect != actual) {
+        std::cerr << "FAILED: " << label << " bin of " << probe
+                  << " is " << actual << ", TAxis says " << expect
+                  << std::endl;
+        good = false;
+      }
+    }
+    return good;
+
+  }  // end 'CheckBinFinder(RAU::Hist::Binning&, std::string&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Check 1D Filler against TH1::Fill
+  // --------------------------------------------------------------------------
+  /*! Values and weights are of type T, e.g. float to
+   *  check filling from NTupleReader columns.
+   */
+  template <typename T> bool CheckFiller1D(
+    const RAU::Hist::Binning& binning,
+    const std::string& label,
+    const bool weighted
+  ) {
+
+    TDirectory::TContext context(nullptr);
+    TRandom3 random(1);
+
+    RAU::Hist::Definition def(label, "", {"x"}, {binning});
+    RAU::Hist::Filler     filler(def);
+
+    const std::vector<double> values = MakeValues(binning.GetBins(), 10000, random);
+    const std::vector<T>      xvals(values.begin(), values.end());
+    std::vector<T>            weights;
+    if (weighted) {
+      for (std::size_t ival = 0; ival < xvals.size(); ++ival) {
+        weights.push_back( random.Uniform(0.5, 2.) );
+      }
+    }
+
+    TH1D* expect = def.MakeTH1();
+    TH1D* actual = def.MakeTH1();
+    for (std::size_t ival = 0; ival < xvals.size(); ++ival) {
+      expect -> Fill(xvals[ival], weighted ? weights[ival] : 1.);
+    }
+    filler.Fill<T>(actual, xvals.data(), weighted ? weights.data() : nullptr, xvals.size());
+
+    const bool same = SameHists(expect, actual, label + (weighted ? " (weighted)" : ""));
+    delete expect;
+    delete actual;
+    return same;
+
+  }  // end 'CheckFiller1D(RAU::Hist::Binning&, std::string&, bool)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Check 2D Filler against TH2::Fill
+  // --------------------------------------------------------------------------
+  bool CheckFiller2D(
+    const RAU::Hist::Binning& xbinning,
+    const RAU::Hist::Binning& ybinning,
+    const std::string& label
+  ) {
+
+    TDirectory::TContext context(nullptr);
+    TRandom3 random(2);
+
+    RAU::Hist::Definition def(label, "", {"x", "y"}, {xbinning, ybinning});
+    RAU::Hist::Filler     filler(def);
+
+    const std::vector<double> xvals = MakeValues(xbinning.GetBins(), 10000, random);
+    const std::vector<double> yvals = MakeValues(ybinning.GetBins(), 10000, random);
+    std::vector<double>       weights;
+    for (std::size_t ival = 0; ival < xvals.size(); ++ival) {
+      weights.push_back( random.Uniform(0.5, 2.) );
+    }
+
+    TH2D* expect = def.MakeTH2();
+    TH2D* actual = def.MakeTH2();
+    for (std::size_t ival = 0; ival < xvals.size(); ++ival) {
+      expect -> Fill(xvals[ival], yvals[ival], weights[ival]);
+    }
+    filler.Fill(actual, xvals.data(), yvals.data(), weights.data(), xvals.size());
+
+    const bool same = SameHists(expect, actual, label);
+    delete expect;
+    delete actual;
+    return same;
+
+  }  // end 'CheckFiller2D(RAU::Hist::Binning& x 2, std::string&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Check that columns built from a histogram match its points
+  // --------------------------------------------------------------------------
+  /*! Compares every column exactly, since both should
+   *  come from the same arithmetic on the same numbers.
+   */
+  bool SameColumns(
+    const RAU::Graph::Columns& actual,
+    const std::vector<RAU::Graph::Point>& points,
+    const std::string& label
+  ) {
+
+    const RAU::Graph::Columns expect(points);
+    const bool same = (actual.x  == expect.x)  && (actual.ex_lo == expect.ex_lo) && (actual.ex_hi == expect.ex_hi)
+                   && (actual.y  == expect.y)  && (actual.ey_lo == expect.ey_lo) && (actual.ey_hi == expect.ey_hi)
+                   && (actual.z  == expect.z)  && (actual.ez_lo == expect.ez_lo) && (actual.ez_hi == expect.ez_hi)
+                   && (actual.ex == expect.ex) && (actual.ey    == expect.ey)    && (actual.ez    == expect.ez);
+    if (!same) {
+      std::cerr << "FAILED: GetHistColumns doesn't match GetHistPoints for '" << label << "'" << std::endl;
+    }
+    return same;
+
+  }  // end 'SameColumns(RAU::Graph::Columns&, std::vector<RAU::Graph::Point>&, std::string&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Check GetHistColumns against GetHistPoints
+  // --------------------------------------------------------------------------
+  /*! Covers the direct reads of TH*D and TH*F arrays
+   *  (with and without squared weights) as well as the
+   *  fallbacks for profiles and non-normal errors.
+   */
+  bool CheckHistColumns() {
+
+    TDirectory::TContext context(nullptr);
+    TRandom3 random(3);
+
+    const std::vector<double> edges = {-1., 0., 0.5, 0.7, 2., 10.};
+
+    // 1D histograms
+    TH1D     th1d("hColTH1D", "", edges.size() - 1, edges.data());
+    TH1F     th1f("hColTH1F", "", 30, -3., 3.);
+    TH1D     poisson("hColPoisson", "", 30, -3., 3.);
+    TProfile profile("hColProfile", "", 30, -3., 3.);
+    th1d.Sumw2();
+    poisson.SetBinErrorOption(TH1::kPoisson);
+    for (std::size_t ival = 0; ival < 2000; ++ival) {
+      const double x = random.Gaus(0., 1.5);
+      const double y = random.Gaus(x, 1.);
+      th1d.Fill(x + 1., random.Uniform(0.5, 2.));
+      th1f.Fill(x);
+      poisson.Fill(x);
+      profile.Fill(x, y);
+    }
+
+    // 2D histograms
+    TH2D       th2d("hColTH2D", "", edges.size() - 1, edges.data(), 12, -3., 3.);
+    TH2F       th2f("hColTH2F", "", 8, -3., 3., 12, -3., 3.);
+    TProfile2D profile2d("hColProfile2D", "", 8, -3., 3., 12, -3., 3.);
+    th2d.Sumw2();
+    for (std::size_t ival = 0; ival < 2000; ++ival) {
+      const double x = random.Gaus(0., 1.5);
+      const double y = random.Gaus(x, 1.);
+      th2d.Fill(x + 1., y, random.Uniform(0.5, 2.));
+      th2f.Fill(x, y);
+      profile2d.Fill(x, y, random.Gaus(x + y, 1.));
+    }
+
+    bool good = true;
+    good &= SameColumns(RAU::Tools::GetHistColumns(&th1d),      RAU::Tools::GetHistPoints(&th1d),      "TH1D");
+    good &= SameColumns(RAU::Tools::GetHistColumns(&th1f),      RAU::Tools::GetHistPoints(&th1f),      "TH1F");
+    good &= SameColumns(RAU::Tools::GetHistColumns(&poisson),   RAU::Tools::GetHistPoints(&poisson),   "TH1D (Poisson errors)");
+    good &= SameColumns(RAU::Tools::GetHistColumns(&profile),   RAU::Tools::GetHistPoints(&profile),   "TProfile");
+    good &= SameColumns(RAU::Tools::GetHistColumns(&th2d),      RAU::Tools::GetHistPoints(&th2d),      "TH2D");
+    good &= SameColumns(RAU::Tools::GetHistColumns(&th2f),      RAU::Tools::GetHistPoints(&th2f),      "TH2F");
+    good &= SameColumns(RAU::Tools::GetHistColumns(&profile2d), RAU::Tools::GetHistPoints(&profile2d), "TProfile2D");
+    return good;
+
+  }  // end 'CheckHistColumns()'
+
+
+
+  // ==========================================================================
+  //! Histogram manager to test with
+  // ==========================================================================
+  /*! A 2D index, e.g. (centrality bin, pt bin). */
+  class Index : public RAU::Hist::Index<2, std::size_t, std::size_t> {
+
+    public:
+
+      void Set(std::size_t row, std::size_t col) override {m_values = {row, col};}
+
+      std::string Hash() override {
+        return std::to_string(m_values[0]) + "_" + std::to_string(m_values[1]);
+      }
+
+      Index() {};
+      Index(std::size_t row, std::size_t col) {Set(row, col);}
+
+  };  // end Index
+
+  /*! Content to fill with. */
+  struct Content {
+    double x = 0.;
+    double y = 0.;
+    double w = 1.;
+  };
+
+  /*! A grid of nrows x ncols indices, each with a 1D
+   *  and a 2D histogram.
+   */
+  class Manager : public RAU::Hist::Manager<Index, Content> {
+
+    private:
+
+      std::size_t m_nrows = 1;
+      std::size_t m_ncols = 1;
+      std::size_t m_hx    = 0;
+      std::size_t m_hxy   = 0;
+
+      void CreateIndices() override {
+        for (std::size_t row = 0; row < m_nrows; ++row) {
+          for (std::size_t col = 0; col < m_ncols; ++col) {
+            AddIndex( Index(row, col) );
+          }
+        }
+      }
+
+    public:
+
+      std::size_t GetHandleX()  const {return m_hx;}
+      std::size_t GetHandleXY() const {return m_hxy;}
+
+      void GenerateHists() override {
+        SetIndexExtents({m_nrows, m_ncols});
+        CreateIndices();
+        m_hx  = AddDefinition1D(
+          RAU::Hist::Definition("hX", "", {"x", "counts"}, {RAU::Hist::Binning(20, -3., 3.)})
+        );
+        m_hxy = AddDefinition2D(
+          RAU::Hist::Definition("hXY", "", {"x", "y", "counts"}, {RAU::Hist::Binning(10, -3., 3.), RAU::Hist::Binning(10, -3., 3.)})
+        );
+        CreateHistCollections();
+      }
+
+      void FillHists(Index index, Content content) override {
+        FillWorkerHists(index, content, 0);
+      }
+
+      void FillWorkerHists(Index index, Content content, const std::size_t worker) override {
+        Fill1D(index, m_hx, content.x, content.w, worker);
+        Fill2D(index, m_hxy, content.x, content.y, content.w, worker);
+      }
+
+      Manager(const std::size_t nrows, const std::size_t ncols, const RAU::Types::Storage storage)
+        : RAU::Hist::Manager<Index, Content>(true, storage)
+        , m_nrows(nrows)
+        , m_ncols(ncols) {};
+
+  };  // end Manager
+
+  // --------------------------------------------------------------------------
+  //! Make random (index, content) pairs to fill a manager with
+  // --------------------------------------------------------------------------
+  /*! Only the first nfilled columns of each row get
+   *  any values, so the rest of the grid stays empty.
+   */
+  std::vector<std::pair<Index, Content>> MakeContents(
+    const std::size_t nrows,
+    const std::size_t nfilled,
+    const std::size_t nvalues,
+    TRandom3& random
+  ) {
+
+    std::vector<std::pair<Index, Content>> contents;
+    for (std::size_t ival = 0; ival < nvalues; ++ival) {
+      const Index   index(random.Integer(nrows), random.Integer(nfilled));
+      const Content content = {random.Gaus(0., 1.), random.Gaus(0., 1.), random.Uniform(0.5, 2.)};
+      contents.emplace_back(index, content);
+    }
+    return contents;
+
+  }  // end 'MakeContents(std::size_t x 3, TRandom3&)'
+
+  // --------------------------------------------------------------------------
+  //! Check flat storage against the grid
+  // --------------------------------------------------------------------------
+  /*! Flat storage should only build histograms on first
+   *  fill, should only save the filled ones, and should
+   *  otherwise give the same histogram as the grid for
+   *  every index.
+   */
+  bool CheckFlatStorage() {
+
+    TDirectory::TContext context(nullptr);
+    TRandom3 random(3);
+
+    const std::size_t nrows   = 3;
+    const std::size_t ncols   = 4;
+    const std::size_t nfilled = 2;
+    const auto        values  = MakeContents(nrows, nfilled, 5000, random);
+
+    Manager grid(nrows, ncols, RAU::Types::Storage::Grid);
+    Manager flat(nrows, ncols, RAU::Types::Storage::Flat);
+    grid.GenerateHists();
+    flat.GenerateHists();
+
+    // nothing should be built before filling
+    bool good = true;
+    if (flat.GetNAllocated() != 0) {
+      std::cerr << "FAILED: flat storage built " << flat.GetNAllocated() << " histograms before filling" << std::endl;
+      good = false;
+    }
+
+    for (const auto& value : values) {
+      grid.FillHists(value.first, value.second);
+      flat.FillHists(value.first, value.second);
+    }
+
+    // only filled indices should be built (1D + 2D each)...
+    const std::size_t nbuilt = 2 * nrows * nfilled;
+    if (flat.GetNAllocated() != nbuilt) {
+      std::cerr << "FAILED: flat storage built " << flat.GetNAllocated() << " histograms, expected " << nbuilt << std::endl;
+      good = false;
+    }
+
+    // ...and saved
+    TMemFile file("TestFlatStorage.root", "recreate");
+    flat.SaveHists(&file);
+    if (file.GetListOfKeys() -> GetSize() != static_cast<int>(nbuilt)) {
+      std::cerr << "FAILED: flat storage saved " << file.GetListOfKeys() -> GetSize() << " histograms, expected " << nbuilt << std::endl;
+      good = false;
+    }
+    file.Close();
+
+    // every index should give the same histograms as the grid
+    for (std::size_t row = 0; row < nrows; ++row) {
+      for (std::size_t col = 0; col < ncols; ++col) {
+        const Index       index(row, col);
+        const std::string label = "flat index " + std::to_string(row) + "_" + std::to_string(col);
+
+        TH1D* expect_x  = grid.GetHist1D(index, grid.GetHandleX());
+        TH1D* actual_x  = flat.GetHist1D(index, flat.GetHandleX());
+        TH2D* expect_xy = grid.GetHist2D(index, grid.GetHandleXY());
+        TH2D* actual_xy = flat.GetHist2D(index, flat.GetHandleXY());
+        good &= (std::string(expect_x -> GetName()) == actual_x -> GetName());
+        good &= (std::string(expect_xy -> GetName()) == actual_xy -> GetName());
+        good &= SameHists(expect_x, actual_x, label + " (1D)");
+        good &= SameHists(expect_xy, actual_xy, label + " (2D)");
+      }
+    }
+    return good;
+
+  }  // end 'CheckFlatStorage()'
+
+  // --------------------------------------------------------------------------
+  //! Check filling from several workers against a single one
+  // --------------------------------------------------------------------------
+  /*! Each worker fills a contiguous block of values into
+   *  its own shard in its own thread. Once merged, every
+   *  histogram should match one filled in a single thread.
+   */
+  bool CheckWorkers(const std::size_t nworkers) {
+
+    TDirectory::TContext context(nullptr);
+    TRandom3 random(4);
+
+    const std::size_t nrows  = 3;
+    const std::size_t ncols  = 4;
+    const auto        values = MakeContents(nrows, ncols, 20000, random);
+
+    Manager single(nrows, ncols, RAU::Types::Storage::Flat);
+    Manager sharded(nrows, ncols, RAU::Types::Storage::Flat);
+    sharded.SetNWorkers(nworkers);
+    single.GenerateHists();
+    sharded.GenerateHists();
+
+    for (const auto& value : values) {
+      single.FillHists(value.first, value.second);
+    }
+
+    const std::size_t        nper = (values.size() + nworkers - 1) / nworkers;
+    std::vector<std::thread> threads;
+    for (std::size_t iwrk = 0; iwrk < nworkers; ++iwrk) {
+      threads.emplace_back(
+        [&, iwrk]() {
+          const std::size_t stop = std::min((iwrk + 1) * nper, values.size());
+          for (std::size_t ival = iwrk * nper; ival < stop; ++ival) {
+            sharded.FillWorkerHists(values[ival].first, values[ival].second, iwrk);
+          }
+        }
+      );
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    sharded.MergeWorkers();
+
+    bool good = true;
+    for (std::size_t row = 0; row < nrows; ++row) {
+      for (std::size_t col = 0; col < ncols; ++col) {
+        const Index       index(row, col);
+        const std::string label = std::to_string(nworkers) + " workers, index " + std::to_string(row) + "_" + std::to_string(col);
+
+        good &= SameHists(
+          single.GetHist1D(index, single.GetHandleX()),
+          sharded.GetHist1D(index, sharded.GetHandleX()),
+          label + " (1D)"
+        );
+        good &= SameHists(
+          single.GetHist2D(index, single.GetHandleXY()),
+          sharded.GetHist2D(index, sharded.GetHandleXY()),
+          label + " (2D)"
+        );
+      }
+    }
+    return good;
+
+  }  // end 'CheckWorkers(std::size_t)'
+
+
+  // --------------------------------------------------------------------------
+  //! Check Hist::Merger against summing inputs with TH1::Add
+  // --------------------------------------------------------------------------
+  /*! Each "job" saves a flat manager to its own file. The
+   *  first job only fills the first column, so histograms
+   *  in the other columns are missing from the first input.
+   *  Only two files are opened at a time so that inputs go
+   *  through a couple of levels of temporary files.
+   */
+  bool CheckMerger(const std::size_t nthreads) {
+
+    TDirectory::TContext context(nullptr);
+    TRandom3 random(5);
+
+    const std::size_t nrows = 2;
+    const std::size_t ncols = 3;
+    const std::size_t njobs = 5;
+
+    // write inputs
+    std::vector<std::string> inputs;
+    for (std::size_t job = 0; job < njobs; ++job) {
+      Manager manager(nrows, ncols, RAU::Types::Storage::Flat);
+      manager.GenerateHists();
+      for (const auto& value : MakeContents(nrows, (job == 0) ? 1 : ncols, 500, random)) {
+        manager.FillHists(value.first, value.second);
+      }
+
+      inputs.push_back( GetScratchPath("merge_input" + std::to_string(job) + ".root") );
+      TFile file(inputs.back().data(), "recreate");
+      manager.SaveHists(&file);
+      file.Close();
+    }
+
+    // list of every histogram a job could have saved
+    Manager lister(nrows, ncols, RAU::Types::Storage::Flat);
+    lister.GenerateHists();
+    const std::vector<RAU::Hist::HistName> names = lister.ListHists();
+
+    // reference is a plain sum over inputs
+    std::map<std::string, TH1*> expect;
+    for (const std::string& input : inputs) {
+      TFile file(input.data(), "read");
+      for (const auto& name : names) {
+        TH1* hist = dynamic_cast<TH1*>( file.Get(name.name.data()) );
+        if (!hist) continue;
+
+        hist -> SetDirectory(nullptr);
+        if (expect.count(name.name) == 0) {
+          expect[name.name] = hist;
+        } else {
+          expect[name.name] -> Add(hist);
+          delete hist;
+        }
+      }
+      file.Close();
+    }
+
+    // merge with the given settings
+    auto merge = [&](const std::string& output, const bool set_hists) {
+      RAU::Hist::Merger merger(inputs);
+      if (set_hists) merger.SetHists(names);
+      merger.SetNThreads(nthreads);
+      merger.SetMaxOpenFiles(2);
+      merger.SetChunkSize(3);
+
+      TFile file(output.data(), "recreate");
+      const std::size_t nwritten = merger.Merge(&file);
+      file.Close();
+      return nwritten;
+    };
+
+    const std::string output_a = GetScratchPath("merge_output_a.root");
+    const std::string output_b = GetScratchPath("merge_output_b.root");
+    const std::string output_c = GetScratchPath("merge_output_c.root");
+
+    bool good = true;
+    if ((merge(output_a, true) != expect.size()) || (merge(output_b, true) != expect.size())) {
+      std::cerr << "FAILED: merger didn't write the expected " << expect.size() << " histograms" << std::endl;
+      good = false;
+    }
+    if (!gSystem -> AccessPathName( (output_a + ".part0_0.root").data() )) {
+      std::cerr << "FAILED: merger didn't remove its temporary files" << std::endl;
+      good = false;
+    }
+
+    // each definition's slice should match the reference,
+    // and be identical between runs with the same settings
+    TFile file_a(output_a.data(), "read");
+    TFile file_b(output_b.data(), "read");
+    std::size_t nloaded = 0;
+    for (const std::string definition : {"hX", "hXY"}) {
+      std::vector<TH1*> slice_a = RAU::Hist::Merger::LoadSlice(&file_a, definition);
+      std::vector<TH1*> slice_b = RAU::Hist::Merger::LoadSlice(&file_b, definition);
+      good &= (slice_a.size() == slice_b.size());
+      for (std::size_t ihist = 0; ihist < std::min(slice_a.size(), slice_b.size()); ++ihist) {
+        const std::string name = slice_a[ihist] -> GetName();
+        if (expect.count(name) == 0) {
+          std::cerr << "FAILED: merger wrote unexpected histogram '" << name << "'" << std::endl;
+          good = false;
+          continue;
+        }
+        good &= SameHists(expect[name], slice_a[ihist], "merged " + name);
+
+        bool identical = (name == slice_b[ihist] -> GetName());
+        identical &= (slice_a[ihist] -> GetEntries() == slice_b[ihist] -> GetEntries());
+        for (int icell = 0; identical && (icell < slice_a[ihist] -> GetNcells()); ++icell) {
+          identical &= (slice_a[ihist] -> GetBinContent(icell) == slice_b[ihist] -> GetBinContent(icell));
+          identical &= (slice_a[ihist] -> GetBinError(icell) == slice_b[ihist] -> GetBinError(icell));
+        }
+        if (!identical) {
+          std::cerr << "FAILED: merging '" << name << "' twice with the same settings gave different results" << std::endl;
+          good = false;
+        }
+        ++nloaded;
+      }
+      for (TH1* hist : slice_a) delete hist;
+      for (TH1* hist : slice_b) delete hist;
+    }
+    if (nloaded != expect.size()) {
+      std::cerr << "FAILED: loaded " << nloaded << " merged histograms, expected " << expect.size() << std::endl;
+      good = false;
+    }
+
+    // a selection should only load what it accepts
+    std::vector<TH1*> selected = RAU::Hist::Merger::LoadSlice(
+      &file_a,
+      "hX",
+      [](const RAU::Hist::HistName& name) {return name.index == "1_0";}
+    );
+    if ((selected.size() != 1) || (std::string(selected.front() -> GetName()) != "hX_1_0")) {
+      std::cerr << "FAILED: LoadSlice selected " << selected.size() << " histograms, expected only 'hX_1_0'" << std::endl;
+      good = false;
+    }
+    for (TH1* hist : selected) delete hist;
+    file_a.Close();
+    file_b.Close();
+
+    // without a list, every histogram found in any
+    // input should still be merged (at the top)
+    merge(output_c, false);
+    TFile file_c(output_c.data(), "read");
+    for (const auto& hist : expect) {
+      TH1* merged = dynamic_cast<TH1*>( file_c.Get(hist.first.data()) );
+      if (!merged) {
+        std::cerr << "FAILED: merger without a list of histograms dropped '" << hist.first << "'" << std::endl;
+        good = false;
+        continue;
+      }
+      merged -> SetDirectory(nullptr);
+      good &= SameHists(hist.second, merged, "merged " + hist.first + " (listed from inputs)");
+      delete merged;
+    }
+    file_c.Close();
+
+    // clean up
+    for (auto& hist : expect) delete hist.second;
+    for (const std::string& path : inputs) gSystem -> Unlink( path.data() );
+    for (const std::string& path : {output_a, output_b, output_c}) gSystem -> Unlink( path.data() );
+    return good;
+
+  }  // end 'CheckMerger(std::size_t)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Write a small TNtuple of random values
+  // --------------------------------------------------------------------------
+  /*! Holds (x, y, z) and a target t = x + 0.5y + noise.
+   *  Baskets are kept small so that each branch spans
+   *  several of them.
+   */
+  void MakeTuple(const std::string& path, const std::size_t nentries, TRandom3& random) {
+
+    TFile   file(path.data(), "recreate");
+    TNtuple tuple("tuple", "test data", "x:y:z:t");
+    tuple.SetBasketSize("*", 512);
+    for (std::size_t ientry = 0; ientry < nentries; ++ientry) {
+      const float x = random.Gaus(0., 1.);
+      const float y = random.Uniform(-1., 1.);
+      const float z = random.Exp(1.);
+      tuple.Fill(x, y, z, x + (0.5 * y) + random.Gaus(0., 0.1));
+    }
+    tuple.Write();
+    file.Close();
+    return;
+
+  }  // end 'MakeTuple(std::string&, std::size_t, TRandom3&)'
+
+  // --------------------------------------------------------------------------
+  //! Check NTupleReader against TTree::GetEntry on a chain
+  // --------------------------------------------------------------------------
+  /*! The chain spans several files (one of them a single
+   *  entry), and blocks straddle both baskets and files.
+   *  Also checks that the chain's branch statuses are put
+   *  back once the reader is gone.
+   */
+  bool CheckNTupleReader() {
+
+    TRandom3 random(5);
+
+    const std::vector<std::size_t> sizes = {2500, 1, 3777};
+    std::vector<std::string>       paths;
+    for (std::size_t ifile = 0; ifile < sizes.size(); ++ifile) {
+      paths.push_back( GetScratchPath("tuple" + std::to_string(ifile) + ".root") );
+      MakeTuple(paths.back(), sizes[ifile], random);
+    }
+
+    // read everything entry by entry first
+    std::vector<std::vector<float>> expect(2);
+    {
+      TChain chain("tuple");
+      for (const std::string& path : paths) chain.Add(path.data());
+
+      float x = 0.;
+      float y = 0.;
+      chain.SetBranchAddress("x", &x);
+      chain.SetBranchAddress("y", &y);
+      for (Long64_t ientry = 0; ientry < chain.GetEntries(); ++ientry) {
+        chain.GetEntry(ientry);
+        expect[0].push_back(x);
+        expect[1].push_back(y);
+      }
+      chain.ResetBranchAddresses();
+    }
+
+    // then block by block
+    TChain chain("tuple");
+    for (const std::string& path : paths) chain.Add(path.data());
+    chain.SetBranchStatus("z", false);
+
+    bool good = true;
+    for (const bool ahead : {false, true}) {
+      RAU::NTupleReader reader(&chain, {"x", "y"}, 1000);
+      reader.SetReadAhead(ahead);
+
+      const std::array<std::size_t, 2> columns = {reader.GetColumn("x"), reader.GetColumn("y")};
+
+      std::size_t nread = 0;
+      while (reader.Next()) {
+        for (std::size_t icol = 0; icol < columns.size(); ++icol) {
+          const float* values = reader.GetData(columns[icol]);
+          for (std::size_t ientry = 0; ientry < reader.GetSize(); ++ientry) {
+            good &= (values[ientry] == expect[icol][reader.GetFirstEntry() + ientry]);
+          }
+        }
+        nread += reader.GetSize();
+      }
+      good &= (nread == expect[0].size());
+    }
+    if (!good) {
+      std::cerr << "FAILED: NTupleReader blocks don't match TTree::GetEntry" << std::endl;
+    }
+
+    // statuses should be as they were before reading
+    const bool restored = chain.GetBranchStatus("x") && chain.GetBranchStatus("y") && !chain.GetBranchStatus("z");
+    if (!restored) {
+      std::cerr << "FAILED: NTupleReader didn't restore branch statuses" << std::endl;
+    }
+
+    for (const std::string& path : paths) {
+      gSystem -> Unlink( path.data() );
+    }
+    return good && restored;
+
+  }  // end 'CheckNTupleReader()'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Check MVA::ReadHelper::EvaluateBlock against EvaluateMethods
+  // --------------------------------------------------------------------------
+  /*! Trains a linear discriminant, then evaluates it
+   *  event by event and block by block with several
+   *  readers. Every output should be identical.
+   */
+  bool CheckEvaluateBlock(const std::size_t nreaders) {
+
+    TRandom3 random(6);
+
+    const std::string path      = GetScratchPath("mva_tuple.root");
+    const std::string training  = GetScratchPath("mva_training.root");
+    const std::string directory = GetScratchPath("mva");
+    MakeTuple(path, 5000, random);
+
+    const std::vector<std::pair<RAU::Types::Use, std::string>> variables = {
+      {RAU::Types::Use::Target, "t"},
+      {RAU::Types::Use::Train,  "x"},
+      {RAU::Types::Use::Train,  "y"},
+      {RAU::Types::Use::Train,  "z"}
+    };
+    const std::vector<std::pair<std::string, std::string>> methods = {
+      {"LD", "!V"}
+    };
+
+    TFile*   file  = TFile::Open(path.data(), "read");
+    TNtuple* tuple = (TNtuple*) file -> Get("tuple");
+
+    // train
+    {
+      RAU::MVA::TrainHelper trainer(variables, methods);
+      trainer.SetFactoryOptions({"!V", "Silent", "AnalysisType=Regression"});
+      trainer.SetTrainOptions({"nTrain_Regression=2000", "nTest_Regression=500", "SplitMode=Random", "!V"});
+
+      TFile*            ofile   = TFile::Open(training.data(), "recreate");
+      TMVA::Factory*    factory = new TMVA::Factory("test", ofile, trainer.CompressFactoryOptions());
+      TMVA::DataLoader* loader  = new TMVA::DataLoader(directory);
+      trainer.LoadVariables(loader);
+      loader -> AddRegressionTree(tuple, 1.);
+      loader -> PrepareTrainingAndTestTree("", trainer.CompressTrainingOptions());
+      trainer.BookMethodsToTrain(factory, loader);
+      factory -> TrainAllMethods();
+      ofile -> cd();
+      ofile -> Close();
+      delete factory;
+      delete loader;
+    }
+
+    // evaluate event by event
+    std::vector<std::vector<float>> expect;
+    {
+      RAU::NTupleHelper    input(tuple);
+      RAU::MVA::ReadHelper helper(variables, methods);
+      TMVA::Reader*        reader = new TMVA::Reader("!Color:Silent");
+      input.SetBranches(tuple);
+      helper.ReadVariables(reader, input);
+      helper.BookMethodsToRead(reader, directory, "test");
+
+      const std::vector<std::string> outputs = helper.GetOutputs();
+      expect.resize(outputs.size());
+      for (Long64_t ientry = 0; ientry < tuple -> GetEntries(); ++ientry) {
+        tuple -> GetEntry(ientry);
+        helper.ResetValues();
+        helper.EvaluateMethods(reader, input);
+        for (std::size_t iout = 0; iout < outputs.size(); ++iout) {
+          expect[iout].push_back( helper.GetVariable(outputs[iout]) );
+        }
+      }
+      tuple -> ResetBranchAddresses();
+      delete reader;
+    }
+
+    // then block by block
+    bool good = true;
+    {
+      RAU::MVA::ReadHelper helper(variables, methods);
+      helper.BookReaderPool(nreaders, directory, "test");
+
+      RAU::NTupleReader               block(tuple, {"x", "y", "z", "t"});
+      std::vector<std::vector<float>> outputs;
+      while (block.Next()) {
+        helper.EvaluateBlock(block, outputs);
+        good &= (outputs.size() == expect.size());
+        for (std::size_t iout = 0; good && (iout < outputs.size()); ++iout) {
+          for (std::size_t ientry = 0; ientry < block.GetSize(); ++ientry) {
+            good &= (outputs[iout][ientry] == expect[iout][block.GetFirstEntry() + ientry]);
+          }
+        }
+      }
+    }
+    if (!good) {
+      std::cerr << "FAILED: EvaluateBlock with " << nreaders << " readers doesn't match EvaluateMethods" << std::endl;
+    }
+
+    file -> Close();
+    gSystem -> Unlink( path.data() );
+    gSystem -> Unlink( training.data() );
+    return good;
+
+  }  // end 'CheckEvaluateBlock(std::size_t)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Check that a plotting batch only reruns changed jobs
+  // --------------------------------------------------------------------------
+  /*! Paths have spaces in them to make sure the manifest
+   *  can still be read back. The input is changed by
+   *  writing a new cycle of its histogram.
+   */
+  bool CheckPlotterBatch() {
+
+    TRandom3 random(7);
+
+    const std::string input    = GetScratchPath("batch input.root");
+    const std::string output   = GetScratchPath("batch plot.root");
+    const std::string manifest = GetScratchPath("batch plots.manifest");
+    gSystem -> Unlink( manifest.data() );
+
+    // write (or add a new cycle of) the histogram to plot
+    auto write = [&](const std::string& option) {
+      TH1D hist("hx", "", 20, -5., 5.);
+      hist.SetDirectory(nullptr);
+      for (std::size_t ival = 0; ival < 1000; ++ival) {
+        hist.Fill( random.Gaus(0., 1.) );
+      }
+
+      TFile file(input.data(), option.data());
+      file.WriteTObject(&hist, "hx");
+      file.Close();
+    };
+    write("recreate");
+
+    const RAU::Plotter::Job job = {
+      {{input, "hx", "hPlotX", "x", RAU::Plot::Style::Plot()}},
+      RAU::Plot::Range({-5., 5.}, {0., 1e3}),
+      RAU::Plot::Canvas("cTest", "", {800, 600}, RAU::Plot::PadOpts()),
+      output,
+      std::string("test")
+    };
+
+    // run, then run again from a fresh batch (should skip),
+    // then change the input (should rerun)
+    const bool was_batch = gROOT -> IsBatch();
+    RAU::Plotter::Base plotter;
+    std::vector<std::size_t> nrun;
+    for (const bool change : {false, false, true, false}) {
+      if (change) write("update");
+
+      RAU::Plotter::Batch batch(plotter, manifest);
+      batch.AddJob(job);
+      batch.Run(1);
+      nrun.push_back( batch.GetNRun() );
+    }
+
+    const bool good = (nrun == std::vector<std::size_t>({1, 0, 1, 0}));
+    if (!good) {
+      std::cerr << "FAILED: plotting batch ran " << nrun[0] << ", " << nrun[1] << ", " << nrun[2] << ", " << nrun[3]
+                << " jobs, expected 1, 0, 1, 0" << std::endl;
+    }
+    const bool restored = (gROOT -> IsBatch() == was_batch);
+    if (!restored) {
+      std::cerr << "FAILED: plotting batch didn't restore batch mode" << std::endl;
+    }
+
+    gSystem -> Unlink( input.data() );
+    gSystem -> Unlink( output.data() );
+    gSystem -> Unlink( manifest.data() );
+    return good && restored;
+
+  }  // end 'CheckPlotterBatch()'
+
+}  // end Test namespace
+
+
+
+// ============================================================================
+//! Run all tests
+// ============================================================================
+/*! Returns true if every check passed.
+ */
+bool TestAnalysisUtilities() {
+
+  // binnings to test with
+  const std::vector<std::pair<std::string, RAU::Hist::Binning>> binnings = {
+    {"uniform",  RAU::Hist::Binning(40, -2., 3.)},
+    {"log",      RAU::Hist::Binning( RAU::Tools::GetBinEdgesLog(50, 0.01, 100.) )},
+    {"variable", RAU::Hist::Binning( std::vector<double>({-1., 0., 0.5, 0.7, 2., 10.}) )},
+    {"wide",     RAU::Hist::Binning( RAU::Tools::GetBinEdgesLog(200, 1., 1e4, 10.) )}
+  };
+
+  // check bin lookup and batch filling against ROOT
+  bool good = true;
+  for (const auto& binning : binnings) {
+    good &= Test::CheckBinFinder(binning.second, binning.first);
+    good &= Test::CheckFiller1D<double>(binning.second, binning.first, false);
+    good &= Test::CheckFiller1D<double>(binning.second, binning.first, true);
+    good &= Test::CheckFiller1D<float>(binning.second, binning.first + " (float)", true);
+  }
+  good &= Test::CheckFiller2D(binnings[0].second, binnings[1].second, "uniform x log");
+  good &= Test::CheckFiller2D(binnings[2].second, binnings[0].second, "variable x uniform");
+
+  // check column-wise decomposition of histograms
+  good &= Test::CheckHistColumns();
+
+  // check histogram managers
+  good &= Test::CheckFlatStorage();
+  good &= Test::CheckWorkers(4);
+
+  // check merging of saved histograms
+  good &= Test::CheckMerger(1);
+  good &= Test::CheckMerger(3);
+
+  // check block reading
+  good &= Test::CheckNTupleReader();
+
+  // check batched MVA evaluation
+  good &= Test::CheckEvaluateBlock(4);
+
+  // check batch plotting
+  good &= Test::CheckPlotterBatch();
+
+  std::cout << (good ? "All tests passed." : "Some tests FAILED!") << std::endl;
+  assert(good);
+  return good;
+
+}  // end 'TestAnalysisUtilities()'
+
+
+
+#ifndef __CLING__
+// ============================================================================
+//! Main
+// ============================================================================
+/*! Exit code is nonzero if any check failed,
+ *  so that ctest picks up failures even when
+ *  asserts are compiled out.
+ */
+int main() {
+
+  return TestAnalysisUtilities() ? 0 : 1;
+
+}  // end 'main()'
+#endif
 
 #endif
 